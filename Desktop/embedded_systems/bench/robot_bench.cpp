@@ -0,0 +1,278 @@
+/**
+ * Robot core benchmarks on the Linux simulator
+ *
+ * Runs the shared control code (robot_core/) on robot_hal_linux.h and reports
+ * the numbers we track across changes:
+ *   control_jitter_us     Deviation of each control period from CONTROL_PERIOD_MS
+ *                         (control task as a real-time thread on the host)
+ *   control_step_ns       CPU time of one controlStep()
+ *   command_to_gpio_us    postCommand() -> motor pins written (real-time thread)
+ *   obstacle_reaction_us  Obstacle appears -> reverse on the motor pins
+ *                         (simulated clock and HC-SR04)
+ *   stream_fps            Frames per second reaching the fastest of three
+ *                         ESP32-CAM viewers, per second of stream
+ *   stream_kbytes_per_s   JPEG data sent to all viewers, per second of stream
+ *   stream_latency_ms     Capture -> frame sent, all viewers
+ *                         (simulated clock, mock camera and WiFi links)
+ *
+ * Usage: robot_bench [--csv] [--seconds N] [--trials N]
+ *   --seconds  Length of the real-time run (default 5)
+ *   --trials   Obstacle reaction trials (default 200)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+#include <random>
+#include <thread>
+
+// Pins of the ESP32 robot (Motor_Esp_32_Code.C)
+#define MOTOR_A_IN1 2
+#define MOTOR_A_IN2 12
+#define MOTOR_B_IN1 13
+#define MOTOR_B_IN2 15
+#define MOTOR_A_EN  26
+#define MOTOR_B_EN  27
+#define TRIG_PIN    14
+#define BUZZER_PIN  25
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/robot_control.h"
+#include "sim/sim_sonar.h"
+#include "sim/sim_stats.h"
+#include "sim/sim_stream.h"
+
+// Stream benchmark: three viewers on WiFi links of different quality
+#define STREAM_SECONDS     20           // Simulated stream time
+#define STREAM_CAPTURE_US  8000         // Sensor readout + JPEG encoding of one frame
+#define STREAM_FRAME_COST  3000         // Per-frame send cost besides the bytes
+
+// Waits for a motor pin pattern to appear on the GPIO recorder
+typedef struct {
+  std::atomic<bool> armed;              // Measurement running
+  std::atomic<uint32_t> pattern;        // Expected motor pin pattern
+  std::atomic<uint64_t> since_us;       // Start of the measurement (simNow())
+  sim_stat_t *stat;                     // Receives the elapsed time
+} motor_watch_t;
+
+robot_control_t robot;
+ultrasonic_t sonar;
+sim_sonar_t sim_sonar;
+motor_watch_t watch;
+sim_stream_t stream;
+
+/**
+ * GPIO hook: stop the measurement when all motor pins show the expected pattern
+ */
+void motorWatchHook(void *ctx, uint64_t clear_mask, uint64_t set_mask) {
+  motor_watch_t *w = (motor_watch_t *)ctx;
+  if (!w->armed.load(std::memory_order_acquire) || ((clear_mask | set_mask) & MOTOR_PIN_MASK) != MOTOR_PIN_MASK ||
+      (set_mask & MOTOR_PIN_MASK) != w->pattern.load(std::memory_order_relaxed)) {
+    return;
+  }
+  w->stat->values.push_back((double)(simNow() - w->since_us.load(std::memory_order_relaxed)));
+  w->armed.store(false, std::memory_order_release);
+}
+
+/**
+ * Start waiting for a motor command to reach the pins
+ * @param cmd - Command whose pattern ends the measurement
+ * @param stat - Receives the elapsed time
+ */
+void armMotorWatch(uint8_t cmd, sim_stat_t *stat) {
+  watch.stat = stat;
+  watch.pattern.store(motor_table[cmd].set_mask, std::memory_order_relaxed);
+  watch.since_us.store(simNow(), std::memory_order_relaxed);
+  watch.armed.store(true, std::memory_order_release);
+}
+
+/**
+ * One control period on the simulated clock
+ */
+void simControlPeriod() {
+  controlStep(&robot, &sonar);
+  simAdvance(CONTROL_PERIOD_MS * 1000);
+}
+
+/**
+ * Obstacle reaction: the robot drives forward, an obstacle appears at a random
+ * time, measured until the reverse pattern reaches the motor pins
+ * @param trials - Number of obstacles
+ * @param reaction - Receives the reaction times
+ */
+void benchObstacleReaction(int trials, sim_stat_t *reaction) {
+  std::mt19937 rng(1);
+  postCommand(&robot, CONTROL_GO, 255);
+
+  for (int i = 0; i < trials; i++) {
+    // Clear path until the median filter has forgotten the last obstacle
+    sim_sonar.distance_cm = 0;
+    int clear_periods = 50 + rng() % 5;
+    for (int p = 0; p < clear_periods; p++) {
+      simControlPeriod();
+    }
+
+    // Obstacle at 3 cm, appearing somewhere inside a control period
+    controlStep(&robot, &sonar);
+    uint32_t offset = rng() % (CONTROL_PERIOD_MS * 1000);
+    simAdvance(offset);
+    sim_sonar.distance_cm = 3;
+    armMotorWatch(CONTROL_BACK, reaction);
+    simAdvance(CONTROL_PERIOD_MS * 1000 - offset);
+    for (int p = 0; p < 100 && watch.armed.load(); p++) {
+      simControlPeriod();
+    }
+    watch.armed.store(false);
+  }
+}
+
+/**
+ * Sleep until an absolute time of the monotonic clock (like vTaskDelayUntil)
+ * @param wake_us - Wake-up time in microseconds
+ */
+void sleepUntil(uint64_t wake_us) {
+  struct timespec ts = { (time_t)(wake_us / 1000000), (long)(wake_us % 1000000) * 1000 };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+  }
+}
+
+/**
+ * Control task as a real-time thread while another thread posts commands
+ * @param seconds - Length of the run
+ * @param jitter - Receives the period deviations
+ * @param step_ns - Receives the controlStep() CPU times
+ * @param latency - Receives the post -> GPIO latencies
+ */
+void benchRealTime(double seconds, sim_stat_t *jitter, sim_stat_t *step_ns, sim_stat_t *latency) {
+  simRealTime(true);
+  sim_sonar.distance_cm = 0;
+  int periods = (int)(seconds * 1000 / CONTROL_PERIOD_MS);
+  std::atomic<bool> running(true);
+
+  std::thread control([&]() {
+    uint64_t wake = simMonotonicUs();
+    uint64_t last_start = 0;
+    for (int i = 0; i < periods; i++) {
+      uint64_t start = simNow();
+      if (last_start) {
+        int64_t deviation = (int64_t)(start - last_start) - CONTROL_PERIOD_MS * 1000;
+        jitter->values.push_back((double)(deviation < 0 ? -deviation : deviation));
+      }
+      last_start = start;
+
+      struct timespec t0, t1;
+      clock_gettime(CLOCK_MONOTONIC, &t0);
+      controlStep(&robot, &sonar);
+      clock_gettime(CLOCK_MONOTONIC, &t1);
+      step_ns->values.push_back((double)((t1.tv_sec - t0.tv_sec) * 1000000000L + (t1.tv_nsec - t0.tv_nsec)));
+
+      wake += CONTROL_PERIOD_MS * 1000;
+      sleepUntil(wake);
+    }
+    running.store(false);
+  });
+
+  // Web server / UDP channel stand-in: a different command every 30-60 ms
+  std::mt19937 rng(2);
+  uint8_t cmd = CONTROL_STOP;
+  while (running.load()) {
+    cmd = (cmd + 1 + rng() % (CONTROL_COMMAND_COUNT - 1)) % CONTROL_COMMAND_COUNT;
+    armMotorWatch(cmd, latency);
+    postCommand(&robot, cmd, 255);
+    sleepUntil(simMonotonicUs() + 30000 + rng() % 30000);
+    watch.armed.store(false);
+  }
+  control.join();
+  simRealTime(false);
+}
+
+/**
+ * Camera stream: capture task and three stream sessions on the mock camera
+ * (resets the simulator, run it last)
+ * @param fps - Receives the fastest viewer's frames per second of stream
+ * @param throughput - Receives the kB sent to all viewers per second of stream
+ * @param latency - Receives the capture -> sent times of all frames
+ * @return false if a frame buffer was leaked or returned twice
+ */
+bool benchStream(sim_stat_t *fps, sim_stat_t *throughput, sim_stat_t *latency) {
+  simStreamInit(&stream, 5, true, STREAM_CAPTURE_US);
+  simStreamAddViewer(&stream, 500000, STREAM_FRAME_COST, latency);   // Good WiFi
+  simStreamAddViewer(&stream, 120000, STREAM_FRAME_COST, latency);   // Next room
+  simStreamAddViewer(&stream, 30000, STREAM_FRAME_COST, latency);    // Edge of range
+
+  uint32_t last_sent = 0;
+  uint64_t last_bytes = 0;
+  for (int s = 0; s < STREAM_SECONDS; s++) {
+    simStreamRun(&stream, 1000000);
+    uint64_t bytes = 0;
+    for (int i = 0; i < SIM_STREAM_VIEWERS; i++) {
+      bytes += stream.viewers[i].bytes;
+    }
+    fps->values.push_back(stream.viewers[0].slot->frames_sent - last_sent);
+    throughput->values.push_back((bytes - last_bytes) / 1000.0);
+    last_sent = stream.viewers[0].slot->frames_sent;
+    last_bytes = bytes;
+  }
+
+  simStreamStop(&stream);
+  return sim_camera.lent_count == 0 && sim_camera.bad_returns == 0;
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  double seconds = 5;
+  int trials = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+      trials = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--seconds N] [--trials N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Same start-up as the robot's setup()
+  motorInit(&robot.motors);
+  ultrasonicInit(&sonar, TRIG_PIN);
+  controlInit(&robot, BUZZER_PIN);
+  simSonarInit(&sim_sonar, &sonar, TRIG_PIN, 0);
+  simAddGpioHook(motorWatchHook, &watch);
+
+  sim_stat_t reaction = { "obstacle_reaction_us", "us", {} };
+  sim_stat_t jitter = { "control_jitter_us", "us", {} };
+  sim_stat_t step_ns = { "control_step_ns", "ns", {} };
+  sim_stat_t latency = { "command_to_gpio_us", "us", {} };
+  sim_stat_t stream_fps = { "stream_fps", "fps", {} };
+  sim_stat_t stream_throughput = { "stream_kbytes_per_s", "kB/s", {} };
+  sim_stat_t stream_latency = { "stream_latency_ms", "ms", {} };
+
+  benchObstacleReaction(trials, &reaction);
+  benchRealTime(seconds, &jitter, &step_ns, &latency);
+  bool buffers_ok = benchStream(&stream_fps, &stream_throughput, &stream_latency);
+
+  simPrintHeader(csv);
+  simPrintStat(&jitter, csv);
+  simPrintStat(&step_ns, csv);
+  simPrintStat(&latency, csv);
+  simPrintStat(&reaction, csv);
+  simPrintStat(&stream_fps, csv);
+  simPrintStat(&stream_throughput, csv);
+  simPrintStat(&stream_latency, csv);
+
+  // Every obstacle must have been answered, every command applied
+  if (reaction.values.size() != (size_t)trials || latency.values.empty()) {
+    fprintf(stderr, "FAIL: %zu/%d obstacles answered, %zu commands applied\n", reaction.values.size(), trials,
+            latency.values.size());
+    return 1;
+  }
+  if (!buffers_ok) {
+    fprintf(stderr, "FAIL: camera frame buffers leaked or returned twice\n");
+    return 1;
+  }
+  return 0;
+}
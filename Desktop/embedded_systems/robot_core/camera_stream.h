@@ -0,0 +1,202 @@
+/**
+ * Capture pacing and quality adaptation of the ESP32-CAM stream
+ *
+ * The capture task runs as fast as the fastest viewer can receive (never
+ * faster than MIN_FRAME_INTERVAL_US); slower viewers skip frames (see
+ * frame_share.h). When even the fastest viewer falls behind, JPEG quality and
+ * then frame size step down, and back up once the link has headroom again.
+ *
+ * planCapture() is the capture task's decision for one frame and
+ * takeStreamFrame() / streamFrameSent() the per-frame bookkeeping of a stream
+ * session; the sketch and sim/sim_stream.h both run them, only the waiting
+ * and sending around them differ.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "robot_hal.h"
+#include "frame_share.h"
+
+// ==== Stream Settings ====
+#define MIN_FRAME_INTERVAL_US  33000    // Fastest capture pacing (~30 fps)
+#define SLOW_SEND_US           100000   // Average send time above this = link falling behind
+#define FAST_SEND_US           40000    // Average send time below this = link has headroom
+#define ADAPT_HOLDOFF_FRAMES   30       // Frames to wait between stream level changes
+
+// Stream quality levels, stepped down while the link falls behind
+typedef struct {
+  hal_frame_size_t frame_size;          // Camera resolution
+  int jpeg_quality;                     // JPEG quality (0-63, lower = better quality)
+} stream_level_t;
+
+inline const stream_level_t stream_levels[] = {
+  { HAL_FRAMESIZE_QQVGA, 12 },          // Default: 160x120, good quality
+  { HAL_FRAMESIZE_QQVGA, 20 },
+  { HAL_FRAMESIZE_QQVGA, 30 },
+  { HAL_FRAMESIZE_96X96, 30 },          // Smallest frames for a congested link
+};
+#define STREAM_LEVEL_COUNT (int)(sizeof(stream_levels) / sizeof(stream_levels[0]))
+
+// Pacing state of the capture task
+typedef struct {
+  int level;                            // Current index into stream_levels
+  int frames_since_adapt;               // Frames since the last stream level change
+} stream_pacer_t;
+
+// One viewer slot, shared by its stream session and the capture task
+// (in_use and send_avg_us are read by the capture task under halEnterCritical())
+typedef struct {
+  bool in_use;                          // Slot taken by a connected viewer
+  uint32_t last_seq;                    // Sequence number of the last frame taken
+  int32_t send_avg_us;                  // Smoothed send time per frame (drives capture pacing)
+  uint32_t frames_sent;                 // Frames sent to this viewer
+  uint32_t frames_dropped;              // Frames skipped because this viewer was busy
+} stream_viewer_t;
+
+// What the capture task does next (see planCapture)
+typedef struct {
+  int viewers;                          // Viewers connected, 0 = nobody watching (do not capture)
+  int32_t fastest_send_us;              // Smallest average send time of the viewers, 0 = none measured yet
+  bool release_latest;                  // Drop the published frame first (idle, or single buffer)
+  bool level_changed;                   // Apply stream_levels[pacer->level] to the camera
+  int32_t interval_us;                  // Time from this capture to the next
+} capture_plan_t;
+
+/**
+ * Smoothed send time of a viewer (1/8 weight for the newest frame)
+ * @param avg_us - Previous average, 0 = no frame sent yet
+ * @param send_us - Send time of the newest frame
+ * @return New average
+ */
+inline int32_t updateSendAverage(int32_t avg_us, int32_t send_us) {
+  return avg_us ? avg_us + (send_us - avg_us) / 8 : send_us;
+}
+
+/**
+ * Step the stream level from the fastest viewer's send time (once per capture)
+ * @param pacer - Pacing state
+ * @param fastest_send_us - Smallest average send time of the viewers, 0 = none measured yet
+ * @return true if the level changed (apply stream_levels[pacer->level] to the camera)
+ */
+inline bool adaptStreamLevel(stream_pacer_t *pacer, int32_t fastest_send_us) {
+  int new_level = pacer->level;
+  if (pacer->frames_since_adapt < ADAPT_HOLDOFF_FRAMES) {
+    pacer->frames_since_adapt++;
+  } else if (fastest_send_us > SLOW_SEND_US && pacer->level < STREAM_LEVEL_COUNT - 1) {
+    new_level++;
+  } else if (fastest_send_us > 0 && fastest_send_us < FAST_SEND_US && pacer->level > 0) {
+    new_level--;
+  }
+  if (new_level == pacer->level) {
+    return false;
+  }
+  pacer->level = new_level;
+  pacer->frames_since_adapt = 0;
+  return true;
+}
+
+/**
+ * Time between captures: what the fastest viewer can receive
+ * @param fastest_send_us - Smallest average send time of the viewers
+ * @return Capture interval in microseconds
+ */
+inline int32_t streamFrameInterval(int32_t fastest_send_us) {
+  return fastest_send_us > MIN_FRAME_INTERVAL_US ? fastest_send_us : MIN_FRAME_INTERVAL_US;
+}
+
+/**
+ * Reserve a free viewer slot for a new stream session
+ * @param viewers - Viewer slots
+ * @param count - Number of slots
+ * @return Slot index, -1 if all are taken
+ */
+inline int reserveStreamViewer(stream_viewer_t *viewers, int count) {
+  int slot = -1;
+  halEnterCritical();
+  for (int i = 0; i < count && slot < 0; i++) {
+    if (!viewers[i].in_use) {
+      viewers[i] = {};
+      viewers[i].in_use = true;
+      slot = i;
+    }
+  }
+  halExitCritical();
+  return slot;
+}
+
+/**
+ * Free a viewer slot (the session has ended or never started)
+ * @param viewer - Slot from reserveStreamViewer()
+ */
+inline void releaseStreamViewer(stream_viewer_t *viewer) {
+  halEnterCritical();
+  viewer->in_use = false;
+  halExitCritical();
+}
+
+/**
+ * Decide the next capture: pace to the fastest viewer (slower viewers skip
+ * frames) and step the stream level from its send time
+ * @param pacer - Pacing state
+ * @param viewers - Viewer slots
+ * @param count - Number of slots
+ * @param fb_count - Frame buffers allocated by halCameraInit()
+ * @return What to do before and after this capture
+ */
+inline capture_plan_t planCapture(stream_pacer_t *pacer, const stream_viewer_t *viewers, int count, int fb_count) {
+  capture_plan_t plan = {};
+  halEnterCritical();
+  for (int i = 0; i < count; i++) {
+    int32_t send_us = viewers[i].send_avg_us;
+    if (viewers[i].in_use) {
+      plan.viewers++;
+      if (send_us > 0 && (plan.fastest_send_us == 0 || send_us < plan.fastest_send_us)) {
+        plan.fastest_send_us = send_us;
+      }
+    }
+  }
+  halExitCritical();
+
+  if (plan.viewers == 0) {
+    plan.release_latest = true;         // Give the last buffer back while nobody is watching
+    return plan;
+  }
+  plan.level_changed = adaptStreamLevel(pacer, plan.fastest_send_us);
+  plan.interval_us = streamFrameInterval(plan.fastest_send_us);
+  plan.release_latest = fb_count == 1;  // The driver needs the published frame back first
+  return plan;
+}
+
+/**
+ * Take the latest frame for a viewer if it has not had it yet
+ * @param share - Broadcaster state
+ * @param viewer - The session's viewer slot
+ * @param dropped - Receives the frames skipped since the previous one
+ * @return Referenced frame (release with releaseFrame), or NULL if nothing new
+ */
+inline shared_frame_t *takeStreamFrame(frame_share_t *share, stream_viewer_t *viewer, uint32_t *dropped) {
+  *dropped = 0;
+  shared_frame_t *frame = acquireLatestFrame(share, viewer->last_seq);
+  if (!frame) {
+    return NULL;
+  }
+  if (viewer->last_seq != 0) {
+    *dropped = frame->seq - viewer->last_seq - 1;
+    viewer->frames_dropped += *dropped;
+  }
+  viewer->last_seq = frame->seq;
+  return frame;
+}
+
+/**
+ * Account a frame sent to a viewer
+ * @param viewer - The session's viewer slot
+ * @param send_us - Time the send took
+ */
+inline void streamFrameSent(stream_viewer_t *viewer, int32_t send_us) {
+  int32_t avg_us = updateSendAverage(viewer->send_avg_us, send_us);
+  halEnterCritical();
+  viewer->send_avg_us = avg_us;         // Read by the capture task
+  halExitCritical();
+  viewer->frames_sent++;
+}
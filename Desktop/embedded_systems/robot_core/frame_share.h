@@ -0,0 +1,112 @@
+/**
+ * Reference-counted camera frames shared between the capture task and the
+ * stream sessions of the ESP32-CAM
+ *
+ * The capture task wraps every frame from halCameraGrab() in a pool slot and
+ * publishes it as the latest frame. A session takes a reference to the latest
+ * frame whenever it is free to send; frames published while it is busy are
+ * skipped (latest frame wins), so a slow viewer never stalls the others. The
+ * buffer goes back to the camera driver when the last reference is dropped.
+ *
+ * The state is guarded by halEnterCritical(); the driver is only called
+ * outside the critical section.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "robot_hal.h"
+
+// Pool slots, one per camera frame buffer (the sketch may define it first)
+#ifndef FRAME_SHARE_SLOTS
+#define FRAME_SHARE_SLOTS  5
+#endif
+
+// Captured frame shared by all stream sessions (reference counted)
+typedef struct {
+  hal_frame_t frame;                    // Frame lent by the camera driver (data NULL = slot free)
+  int64_t captured_us;                  // Capture timestamp for latency measurement
+  uint32_t seq;                         // Frame sequence number (detects dropped frames)
+  int refs;                             // Holders: broadcaster (while latest) + sending sessions
+} shared_frame_t;
+
+// Frame broadcaster state (capture task -> stream sessions)
+typedef struct {
+  shared_frame_t pool[FRAME_SHARE_SLOTS];  // One slot per camera frame buffer
+  shared_frame_t *latest;               // Newest frame, handed to every session
+  uint32_t seq;                         // Sequence number of the newest frame
+} frame_share_t;
+
+/**
+ * Wrap a captured frame in a free pool slot
+ * @param share - Broadcaster state
+ * @param fb - Frame from halCameraGrab()
+ * @param captured_us - Capture timestamp
+ * @return Frame holding the broadcaster reference (publish it with publishFrame),
+ *         or NULL if no slot is free (give the buffer back to the driver)
+ */
+inline shared_frame_t *shareFrame(frame_share_t *share, const hal_frame_t *fb, int64_t captured_us) {
+  shared_frame_t *frame = NULL;
+  halEnterCritical();
+  for (int i = 0; i < FRAME_SHARE_SLOTS && !frame; i++) {
+    if (share->pool[i].frame.data == NULL) {
+      frame = &share->pool[i];
+      frame->frame = *fb;
+      frame->captured_us = captured_us;
+      frame->seq = ++share->seq;
+      frame->refs = 1;                  // Broadcaster reference, dropped when replaced
+    }
+  }
+  halExitCritical();
+  return frame;
+}
+
+/**
+ * Drop a frame reference, the buffer goes back to the camera driver with the last one
+ * @param frame - Frame from shareFrame() or acquireLatestFrame()
+ */
+inline void releaseFrame(shared_frame_t *frame) {
+  halEnterCritical();
+  bool last = --frame->refs == 0;
+  halExitCritical();
+
+  if (last) {
+    halCameraReturn(&frame->frame);
+    halEnterCritical();
+    frame->frame.data = NULL;           // Pool slot free again
+    halExitCritical();
+  }
+}
+
+/**
+ * Make a frame the latest one (the caller then wakes the sessions)
+ * @param share - Broadcaster state
+ * @param frame - New latest frame from shareFrame(), or NULL to drop the latest frame
+ */
+inline void publishFrame(frame_share_t *share, shared_frame_t *frame) {
+  halEnterCritical();
+  shared_frame_t *old = share->latest;
+  share->latest = frame;
+  halExitCritical();
+
+  if (old) {
+    releaseFrame(old);                  // Sessions still sending it keep it alive
+  }
+}
+
+/**
+ * Take a reference to the latest frame if it is newer than the last one sent
+ * @param share - Broadcaster state
+ * @param last_seq - Sequence number of the caller's last frame
+ * @return Referenced frame (release with releaseFrame), or NULL if nothing new
+ */
+inline shared_frame_t *acquireLatestFrame(frame_share_t *share, uint32_t last_seq) {
+  shared_frame_t *frame = NULL;
+  halEnterCritical();
+  if (share->latest && share->latest->seq != last_seq) {
+    frame = share->latest;
+    frame->refs++;
+  }
+  halExitCritical();
+  return frame;
+}
@@ -0,0 +1,136 @@
+/**
+ * Tilt filter and command classifier for the IMU remote
+ *
+ * A complementary filter fuses the MPU6050 gyro (fast, drifts) with the
+ * accelerometer tilt (noisy, no drift). The classifier turns the filtered
+ * tilt into a movement command with hysteresis plus a proportional speed,
+ * so single-sample spikes no longer flip the direction.
+ *
+ * Axis convention (same as the old raw thresholds):
+ *   tilting forward  -> negative AY -> CONTROL_GO
+ *   tilting backward -> positive AY -> CONTROL_BACK
+ *   tilting right    -> positive AX -> CONTROL_RIGHT
+ *   tilting left     -> negative AX -> CONTROL_LEFT
+ *
+ * Plain C++ without Arduino dependencies, so it also builds on a PC.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+#include "robot_protocol.h"
+
+// ==== Sensor Scaling (MPU6050 at ±2g / ±250 °/s) ====
+#define IMU_ACCEL_LSB_PER_G    16384.0f  // Accelerometer counts per g
+#define IMU_GYRO_LSB_PER_DPS   131.0f    // Gyro counts per degree/second
+
+// ==== Filter and Classifier Tuning ====
+#define TILT_FILTER_ALPHA      0.98f     // Gyro weight of the complementary filter
+#define DRIVE_ENTER_DEG        35.0f     // Forward/back tilt to start moving (old threshold: ±10000 raw)
+#define DRIVE_EXIT_DEG         25.0f     // Forward/back tilt below which the command is released
+#define TURN_ENTER_DEG         28.0f     // Sideways tilt to start turning (old threshold: ±8000 raw)
+#define TURN_EXIT_DEG          18.0f     // Sideways tilt below which the turn is released
+#define FULL_SPEED_DEG         60.0f     // Tilt for full speed
+#define MIN_DRIVE_SPEED        80        // Lowest speed sent while moving (motor dead band)
+
+// One raw MPU6050 sample
+typedef struct {
+  int16_t ax, ay, az;                   // Acceleration (counts)
+  int16_t gx, gy, gz;                   // Angular rate (counts)
+} imu_sample_t;
+
+// Complementary filter state
+typedef struct {
+  float roll_deg;                       // Rotation about X (negative = tilted forward)
+  float pitch_deg;                      // Rotation about Y (negative = tilted right)
+  bool initialized;                     // False until the first sample seeds the angles
+} tilt_filter_t;
+
+// Classifier output
+typedef struct {
+  uint8_t command;                      // control_command_t value
+  uint8_t speed;                        // 0-255, proportional to the tilt
+} tilt_command_t;
+
+/**
+ * Feed one sample into the complementary filter
+ * @param filter - Filter state
+ * @param sample - Raw IMU sample
+ * @param dt - Time since the previous sample in seconds
+ */
+inline void updateTiltFilter(tilt_filter_t *filter, const imu_sample_t *sample, float dt) {
+  const float rad_to_deg = 57.2957795f;
+  float ax = sample->ax / IMU_ACCEL_LSB_PER_G;
+  float ay = sample->ay / IMU_ACCEL_LSB_PER_G;
+  float az = sample->az / IMU_ACCEL_LSB_PER_G;
+
+  // Tilt seen by the accelerometer (valid while the remote is not accelerating)
+  float accel_roll = atan2f(ay, sqrtf(ax * ax + az * az)) * rad_to_deg;
+  float accel_pitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * rad_to_deg;
+
+  if (!filter->initialized) {
+    filter->roll_deg = accel_roll;
+    filter->pitch_deg = accel_pitch;
+    filter->initialized = true;
+    return;
+  }
+
+  // Integrate the gyro, pull slowly towards the accelerometer tilt
+  float roll_rate = sample->gx / IMU_GYRO_LSB_PER_DPS;
+  float pitch_rate = sample->gy / IMU_GYRO_LSB_PER_DPS;
+  filter->roll_deg = TILT_FILTER_ALPHA * (filter->roll_deg + roll_rate * dt) + (1.0f - TILT_FILTER_ALPHA) * accel_roll;
+  filter->pitch_deg = TILT_FILTER_ALPHA * (filter->pitch_deg + pitch_rate * dt) + (1.0f - TILT_FILTER_ALPHA) * accel_pitch;
+}
+
+/**
+ * Map a tilt angle to a speed between MIN_DRIVE_SPEED and 255
+ * @param tilt_deg - Tilt along the active axis (absolute value)
+ * @param exit_deg - Release threshold of that axis
+ * @return Speed 0-255
+ */
+inline uint8_t tiltToSpeed(float tilt_deg, float exit_deg) {
+  float fraction = (tilt_deg - exit_deg) / (FULL_SPEED_DEG - exit_deg);
+  if (fraction < 0.0f) fraction = 0.0f;
+  if (fraction > 1.0f) fraction = 1.0f;
+  return (uint8_t)(MIN_DRIVE_SPEED + fraction * (255 - MIN_DRIVE_SPEED));
+}
+
+/**
+ * Turn the filtered tilt into a movement command
+ * The current command is kept until its tilt drops below the exit threshold,
+ * a new command needs the (higher) enter threshold
+ * @param filter - Filtered tilt
+ * @param current - Command currently being sent
+ * @return Command and proportional speed
+ */
+inline tilt_command_t classifyTilt(const tilt_filter_t *filter, uint8_t current) {
+  float forward = -filter->roll_deg;    // Positive = tilted forward
+  float right = -filter->pitch_deg;     // Positive = tilted right
+  tilt_command_t result = { CONTROL_STOP, 0 };
+
+  // Hold the current command while its tilt stays above the exit threshold
+  if (current == CONTROL_GO && forward > DRIVE_EXIT_DEG) {
+    result.command = CONTROL_GO;
+  } else if (current == CONTROL_BACK && -forward > DRIVE_EXIT_DEG) {
+    result.command = CONTROL_BACK;
+  } else if (current == CONTROL_RIGHT && right > TURN_EXIT_DEG) {
+    result.command = CONTROL_RIGHT;
+  } else if (current == CONTROL_LEFT && -right > TURN_EXIT_DEG) {
+    result.command = CONTROL_LEFT;
+  } else if (forward > DRIVE_ENTER_DEG) {   // Forward/back take priority over turning
+    result.command = CONTROL_GO;
+  } else if (-forward > DRIVE_ENTER_DEG) {
+    result.command = CONTROL_BACK;
+  } else if (right > TURN_ENTER_DEG) {
+    result.command = CONTROL_RIGHT;
+  } else if (-right > TURN_ENTER_DEG) {
+    result.command = CONTROL_LEFT;
+  }
+
+  if (result.command == CONTROL_GO || result.command == CONTROL_BACK) {
+    result.speed = tiltToSpeed(fabsf(forward), DRIVE_EXIT_DEG);
+  } else if (result.command != CONTROL_STOP) {
+    result.speed = tiltToSpeed(fabsf(right), TURN_EXIT_DEG);
+  }
+  return result;
+}
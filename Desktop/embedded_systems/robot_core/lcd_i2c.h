@@ -0,0 +1,113 @@
+/**
+ * HD44780 character LCD on a PCF8574 I2C backpack (I2C through robot_hal.h)
+ *
+ * Replaces LiquidCrystal_I2C. A character or command is one I2C transaction
+ * of four expander bytes (each nibble with and without the enable strobe)
+ * where the library used six single-byte transactions. lcdI2cSetCursor() and
+ * lcdI2cWrite() are the pair renderLcdRow() (lcd_renderer.h) draws with.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "robot_hal.h"
+
+// PCF8574 outputs of the common backpacks (P4-P7 = D4-D7)
+#define LCD_I2C_RS         0x01   // Register select: 1 = character data
+#define LCD_I2C_EN         0x04   // Enable strobe, latched on the falling edge
+#define LCD_I2C_BACKLIGHT  0x08   // Backlight transistor
+
+// HD44780 commands
+#define LCD_CMD_CLEAR      0x01
+#define LCD_CMD_ENTRY      0x06   // Cursor moves right, no display shift
+#define LCD_CMD_DISPLAY    0x0C   // Display on, cursor and blink off
+#define LCD_CMD_FUNCTION   0x28   // 4-bit bus, 2 lines, 5x8 font
+#define LCD_CMD_DDRAM      0x80   // Set cursor address
+
+/**
+ * Send one byte as two nibbles in a single I2C transaction
+ * @param addr - PCF8574 address
+ * @param flags - LCD_I2C_RS and/or LCD_I2C_BACKLIGHT
+ * @param value - Command or character
+ * @return false if the backpack did not acknowledge
+ */
+inline bool lcdI2cSend(uint8_t addr, uint8_t flags, uint8_t value) {
+  uint8_t high = (value & 0xF0) | flags;
+  uint8_t low = (uint8_t)(value << 4) | flags;
+  uint8_t bytes[4] = { (uint8_t)(high | LCD_I2C_EN), high, (uint8_t)(low | LCD_I2C_EN), low };
+  return halI2cWrite(addr, bytes, sizeof(bytes));
+}
+
+// One display
+typedef struct {
+  uint8_t addr;                         // PCF8574 address
+  uint8_t backlight;                    // LCD_I2C_BACKLIGHT or 0
+} lcd_i2c_t;
+
+/**
+ * Reset the display into 4-bit mode, clear it and switch the backlight on
+ * @param lcd - Display
+ * @param addr - PCF8574 address (0x27 or 0x3F on most backpacks)
+ * @return false if the backpack did not acknowledge
+ */
+inline bool lcdI2cInit(lcd_i2c_t *lcd, uint8_t addr) {
+  lcd->addr = addr;
+  lcd->backlight = LCD_I2C_BACKLIGHT;
+  halDelayMicros(50000);                // Power-up time of the controller
+
+  // Reset by instruction: three times "8-bit mode", then "4-bit mode", one nibble each
+  static const uint8_t nibbles[] = { 0x30, 0x30, 0x30, 0x20 };
+  static const uint32_t waits_us[] = { 4500, 4500, 150, 150 };
+  for (int i = 0; i < 4; i++) {
+    uint8_t bytes[2] = { (uint8_t)(nibbles[i] | LCD_I2C_BACKLIGHT | LCD_I2C_EN), (uint8_t)(nibbles[i] | LCD_I2C_BACKLIGHT) };
+    if (!halI2cWrite(addr, bytes, sizeof(bytes))) {
+      return false;
+    }
+    halDelayMicros(waits_us[i]);
+  }
+
+  lcdI2cSend(addr, lcd->backlight, LCD_CMD_FUNCTION);
+  lcdI2cSend(addr, lcd->backlight, LCD_CMD_DISPLAY);
+  lcdI2cSend(addr, lcd->backlight, LCD_CMD_ENTRY);
+  lcdI2cSend(addr, lcd->backlight, LCD_CMD_CLEAR);
+  halDelayMicros(2000);                 // Clear takes 1.52 ms
+  return true;
+}
+
+/**
+ * Clear the display and move the cursor home
+ * @param lcd - Display
+ */
+inline void lcdI2cClear(lcd_i2c_t *lcd) {
+  lcdI2cSend(lcd->addr, lcd->backlight, LCD_CMD_CLEAR);
+  halDelayMicros(2000);
+}
+
+/**
+ * Move the cursor
+ * @param lcd - Display
+ * @param col - Column
+ * @param row - Row (0 or 1)
+ */
+inline void lcdI2cSetCursor(lcd_i2c_t *lcd, int col, int row) {
+  lcdI2cSend(lcd->addr, lcd->backlight, LCD_CMD_DDRAM | (col + (row ? 0x40 : 0)));
+}
+
+/**
+ * Write one character at the cursor
+ * @param lcd - Display
+ * @param c - Character
+ */
+inline void lcdI2cWrite(lcd_i2c_t *lcd, char c) {
+  lcdI2cSend(lcd->addr, lcd->backlight | LCD_I2C_RS, (uint8_t)c);
+}
+
+/**
+ * Write text at the cursor
+ * @param lcd - Display
+ * @param text - Text
+ */
+inline void lcdI2cPrint(lcd_i2c_t *lcd, const char *text) {
+  while (*text) {
+    lcdI2cWrite(lcd, *text++);
+  }
+}
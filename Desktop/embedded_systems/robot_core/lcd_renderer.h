@@ -0,0 +1,81 @@
+/**
+ * Diff-based renderer for the 16x2 character LCD
+ *
+ * Keeps a shadow copy of what the display shows and only writes the character
+ * cells that differ from the new frame: one cursor move per run of changed
+ * cells, then the characters. Each character is a slow I2C transaction, so an
+ * unchanged frame costs nothing.
+ *
+ * The display is drawn through a cursor-move and a write-character function
+ * taking a pointer to the display (lcdI2cSetCursor() / lcdI2cWrite() of
+ * lcd_i2c.h on the remote), so the renderer also runs on a PC against a
+ * stand-in display.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define LCD_COLS  16    // Characters per row
+#define LCD_ROWS  2     // Rows
+
+// Full display contents
+typedef struct {
+  char cells[LCD_ROWS][LCD_COLS];
+} lcd_frame_t;
+
+/**
+ * Fill a frame with spaces (what the LCD shows after clear())
+ * @param frame - Frame to clear
+ */
+inline void clearLcdFrame(lcd_frame_t *frame) {
+  memset(frame->cells, ' ', sizeof(frame->cells));
+}
+
+/**
+ * Put text into one row of a frame, padded with spaces and cut at LCD_COLS
+ * @param frame - Frame to modify
+ * @param row - Row index
+ * @param text - Text to show
+ */
+inline void setLcdRow(lcd_frame_t *frame, int row, const char *text) {
+  size_t len = strlen(text);
+  if (len > LCD_COLS) {
+    len = LCD_COLS;
+  }
+  memcpy(frame->cells[row], text, len);
+  memset(frame->cells[row] + len, ' ', LCD_COLS - len);
+}
+
+/**
+ * Bring one display row from the shadow contents to the target frame
+ * @param display - LCD driver state
+ * @param set_cursor - Moves the display's cursor to (col, row)
+ * @param write - Writes one character at the cursor
+ * @param shown - Shadow copy of the display, updated as cells are written
+ * @param target - Frame to show
+ * @param row - Row index
+ * @return Number of characters written to the display
+ */
+template <typename Display>
+int renderLcdRow(Display *display, void (*set_cursor)(Display *, int, int), void (*write)(Display *, char),
+                 lcd_frame_t *shown, const lcd_frame_t *target, int row) {
+  int written = 0;
+  int col = 0;
+  while (col < LCD_COLS) {
+    if (shown->cells[row][col] == target->cells[row][col]) {
+      col++;
+      continue;
+    }
+
+    // Start of a run of changed cells: one cursor move, then the characters
+    set_cursor(display, col, row);
+    while (col < LCD_COLS && shown->cells[row][col] != target->cells[row][col]) {
+      write(display, target->cells[row][col]);
+      shown->cells[row][col] = target->cells[row][col];
+      col++;
+      written++;
+    }
+  }
+  return written;
+}
@@ -0,0 +1,113 @@
+/**
+ * Table-driven L298N motor outputs
+ *
+ * Every movement command maps to one precomputed pattern of direction pins,
+ * so a command change is one clear and one set register write, and the
+ * enable PWM duty is only written when it changes (the last written duty is
+ * kept in motor_driver_t and forgotten by motorInit()).
+ *
+ * The board pins are compile-time settings: define MOTOR_A_IN1, MOTOR_A_IN2,
+ * MOTOR_B_IN1, MOTOR_B_IN2, MOTOR_A_EN and MOTOR_B_EN (-1 = enable pin not
+ * wired, full speed only) before including this header.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "robot_hal.h"
+#include "robot_protocol.h"
+
+#if !defined(MOTOR_A_IN1) || !defined(MOTOR_A_IN2) || !defined(MOTOR_B_IN1) || !defined(MOTOR_B_IN2) || \
+    !defined(MOTOR_A_EN) || !defined(MOTOR_B_EN)
+#error "Define the MOTOR_* pins before including motor_driver.h"
+#endif
+
+// ==== Motor Output Table ====
+#define MOTOR_PWM_FREQ  1000   // Enable pin PWM frequency in Hz
+#define MOTOR_PWM_BITS  8      // PWM resolution (duty 0-255 = command speed)
+#define MOTOR_PIN_MASK  ((1UL << MOTOR_A_IN1) | (1UL << MOTOR_A_IN2) | (1UL << MOTOR_B_IN1) | (1UL << MOTOR_B_IN2))
+
+// Output pattern for one movement command
+typedef struct {
+  uint32_t set_mask;                    // Direction pins driven HIGH, the other motor pins go LOW
+  bool a_on;                            // Motor A driven (enable duty = speed)
+  bool b_on;                            // Motor B driven (enable duty = speed)
+} motor_output_t;
+
+/**
+ * Build a motor output pattern at compile time
+ * @param a_dir - Motor A direction (1 forward, -1 backward, 0 off)
+ * @param b_dir - Motor B direction (1 forward, -1 backward, 0 off)
+ */
+constexpr motor_output_t motorOutput(int a_dir, int b_dir) {
+  return motor_output_t{
+    (a_dir > 0 ? 1U << MOTOR_A_IN1 : 0) | (a_dir < 0 ? 1U << MOTOR_A_IN2 : 0) |
+    (b_dir > 0 ? 1U << MOTOR_B_IN1 : 0) | (b_dir < 0 ? 1U << MOTOR_B_IN2 : 0),
+    a_dir != 0, b_dir != 0 };
+}
+
+// Movement command -> motor outputs, indexed by control_command_t
+constexpr motor_output_t motor_table[CONTROL_COMMAND_COUNT] = {
+  motorOutput( 0,  0),                  // CONTROL_STOP  - all motor pins LOW
+  motorOutput( 1,  1),                  // CONTROL_GO    - both motors forward
+  motorOutput(-1, -1),                  // CONTROL_BACK  - both motors backward
+  motorOutput(-1,  1),                  // CONTROL_LEFT  - left backward, right forward
+  motorOutput( 1, -1),                  // CONTROL_RIGHT - left forward, right backward
+};
+static_assert(CONTROL_STOP == 0 && CONTROL_GO == 1 && CONTROL_BACK == 2 && CONTROL_LEFT == 3 && CONTROL_RIGHT == 4,
+              "motor_table order must match control_command_t");
+static_assert(MOTOR_A_IN1 < 32 && MOTOR_A_IN2 < 32 && MOTOR_B_IN1 < 32 && MOTOR_B_IN2 < 32,
+              "Motor pins must be GPIO0-31 (single GPIO_OUT register)");
+
+// Motor driver state
+typedef struct {
+  int duty_a;                           // Duty last written to MOTOR_A_EN, -1 = unknown (write it)
+  int duty_b;                           // Duty last written to MOTOR_B_EN, -1 = unknown (write it)
+} motor_driver_t;
+
+/**
+ * Configure the motor pins (all LOW = stopped) and the enable PWM
+ * @param motors - Driver state (the enable duty is written again on the next command)
+ */
+inline void motorInit(motor_driver_t *motors) {
+  motors->duty_a = -1;
+  motors->duty_b = -1;
+  halGpioOutput(MOTOR_A_IN1);
+  halGpioOutput(MOTOR_A_IN2);
+  halGpioOutput(MOTOR_B_IN1);
+  halGpioOutput(MOTOR_B_IN2);
+#if MOTOR_A_EN >= 0 && MOTOR_B_EN >= 0
+  // Enable pins carry the command speed as PWM duty
+  halPwmAttach(MOTOR_A_EN, MOTOR_PWM_FREQ, MOTOR_PWM_BITS);
+  halPwmAttach(MOTOR_B_EN, MOTOR_PWM_FREQ, MOTOR_PWM_BITS);
+#endif
+}
+
+/**
+ * Drive the motors for a movement command
+ * @param motors - Driver state
+ * @param cmd - Movement command (control_command_t)
+ * @param speed - Speed 0-255 (PWM duty of the driven motors)
+ */
+inline void applyMotorCommand(motor_driver_t *motors, uint8_t cmd, uint8_t speed) {
+  const motor_output_t &out = motor_table[cmd < CONTROL_COMMAND_COUNT ? cmd : (uint8_t)CONTROL_STOP];
+
+  // Release pins first so IN1 and IN2 of a motor are never HIGH together
+  halGpioWriteMask(MOTOR_PIN_MASK & ~out.set_mask, out.set_mask);
+
+#if MOTOR_A_EN >= 0 && MOTOR_B_EN >= 0
+  // Skip redundant duty writes
+  int new_a = out.a_on ? speed : 0;
+  int new_b = out.b_on ? speed : 0;
+  if (new_a != motors->duty_a) {
+    halPwmWrite(MOTOR_A_EN, new_a);
+    motors->duty_a = new_a;
+  }
+  if (new_b != motors->duty_b) {
+    halPwmWrite(MOTOR_B_EN, new_b);
+    motors->duty_b = new_b;
+  }
+#else
+  (void)motors;
+  (void)speed;                          // Enable jumpers fitted - always full speed
+#endif
+}
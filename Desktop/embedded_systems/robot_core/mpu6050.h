@@ -0,0 +1,115 @@
+/**
+ * MPU6050 driver for the IMU remote (register level, I2C through robot_hal.h)
+ *
+ * Samples accelerometer and gyro into the sensor's FIFO with a data-ready
+ * interrupt per sample; the remote drains the FIFO in bursts. Replaces the
+ * i2cdevlib MPU6050 library so the sampling code also runs on the Linux
+ * simulator.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "robot_hal.h"
+#include "imu_filter.h"
+
+// ==== Device ====
+#define MPU6050_ADDR               0x68   // AD0 low
+#define MPU6050_FIFO_SAMPLE_BYTES  12     // Accel XYZ + gyro XYZ, 16 bit big endian each
+#define MPU6050_FIFO_SIZE          1024   // FIFO size in bytes
+
+// Registers
+#define MPU6050_SMPLRT_DIV    0x19
+#define MPU6050_CONFIG        0x1A
+#define MPU6050_GYRO_CONFIG   0x1B
+#define MPU6050_ACCEL_CONFIG  0x1C
+#define MPU6050_FIFO_EN       0x23
+#define MPU6050_INT_ENABLE    0x38
+#define MPU6050_USER_CTRL     0x6A
+#define MPU6050_PWR_MGMT_1    0x6B
+#define MPU6050_FIFO_COUNTH   0x72
+#define MPU6050_FIFO_R_W      0x74
+#define MPU6050_WHO_AM_I      0x75
+
+/**
+ * Write one register
+ * @param reg - Register
+ * @param value - Value
+ * @return false if the sensor did not acknowledge
+ */
+inline bool mpu6050WriteReg(uint8_t reg, uint8_t value) {
+  uint8_t bytes[2] = { reg, value };
+  return halI2cWrite(MPU6050_ADDR, bytes, sizeof(bytes));
+}
+
+/**
+ * Check the sensor and start sampling into the FIFO
+ * (±2 g, ±250 °/s, 42 Hz low-pass, see IMU_ACCEL_LSB_PER_G / IMU_GYRO_LSB_PER_DPS)
+ * @param sample_rate_hz - Samples per second (1000 / n)
+ * @return false if no MPU6050 answered
+ */
+inline bool mpu6050Init(uint16_t sample_rate_hz) {
+  uint8_t who_am_i;
+  if (!halI2cRead(MPU6050_ADDR, MPU6050_WHO_AM_I, &who_am_i, 1) || ((who_am_i >> 1) & 0x3F) != 0x34) {
+    return false;
+  }
+  return mpu6050WriteReg(MPU6050_PWR_MGMT_1, 0x01) &&     // Wake up, clock from the X gyro PLL
+         mpu6050WriteReg(MPU6050_CONFIG, 0x03) &&         // 42 Hz low-pass, 1 kHz internal rate
+         mpu6050WriteReg(MPU6050_SMPLRT_DIV, 1000 / sample_rate_hz - 1) &&
+         mpu6050WriteReg(MPU6050_GYRO_CONFIG, 0x00) &&    // ±250 °/s
+         mpu6050WriteReg(MPU6050_ACCEL_CONFIG, 0x00) &&   // ±2 g
+         mpu6050WriteReg(MPU6050_FIFO_EN, 0x78) &&        // Gyro XYZ and accel into the FIFO
+         mpu6050WriteReg(MPU6050_INT_ENABLE, 0x01) &&     // INT pulse for every new sample
+         mpu6050WriteReg(MPU6050_USER_CTRL, 0x44);        // Enable and reset the FIFO
+}
+
+/**
+ * Drop the FIFO contents (after an overflow they are no longer sample aligned)
+ */
+inline void mpu6050ResetFifo() {
+  mpu6050WriteReg(MPU6050_USER_CTRL, 0x44);
+}
+
+/**
+ * Number of bytes waiting in the FIFO
+ * @return FIFO fill level, MPU6050_FIFO_SIZE or more means it overflowed
+ */
+inline uint16_t mpu6050FifoCount() {
+  uint8_t bytes[2];
+  if (!halI2cRead(MPU6050_ADDR, MPU6050_FIFO_COUNTH, bytes, sizeof(bytes))) {
+    return 0;
+  }
+  return (bytes[0] << 8) | bytes[1];
+}
+
+/**
+ * Read bytes from the FIFO (in pieces the I2C driver can buffer)
+ * @param buf - Receives the bytes
+ * @param len - Number of bytes
+ * @return false if the sensor did not answer
+ */
+inline bool mpu6050ReadFifo(uint8_t *buf, size_t len) {
+  while (len > 0) {
+    size_t part = len < HAL_I2C_MAX_READ ? len : HAL_I2C_MAX_READ;
+    if (!halI2cRead(MPU6050_ADDR, MPU6050_FIFO_R_W, buf, part)) {
+      return false;
+    }
+    buf += part;
+    len -= part;
+  }
+  return true;
+}
+
+/**
+ * Decode one FIFO sample
+ * @param bytes - MPU6050_FIFO_SAMPLE_BYTES bytes from the FIFO
+ * @param sample - Decoded sample
+ */
+inline void mpu6050ParseSample(const uint8_t *bytes, imu_sample_t *sample) {
+  sample->ax = (int16_t)((bytes[0] << 8) | bytes[1]);
+  sample->ay = (int16_t)((bytes[2] << 8) | bytes[3]);
+  sample->az = (int16_t)((bytes[4] << 8) | bytes[5]);
+  sample->gx = (int16_t)((bytes[6] << 8) | bytes[7]);
+  sample->gy = (int16_t)((bytes[8] << 8) | bytes[9]);
+  sample->gz = (int16_t)((bytes[10] << 8) | bytes[11]);
+}
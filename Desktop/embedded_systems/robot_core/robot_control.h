@@ -0,0 +1,235 @@
+/**
+ * Robot control core shared by the ESP32 and ESP32-CAM robots
+ *
+ * - Command mailbox: the web server and the UDP channel post the latest
+ *   movement command, the control task picks it up (one atomic word, no lock)
+ * - controlStep(): one period of the fixed-rate control task (deadman,
+ *   obstacle check, motor outputs)
+ * - UDP control channel: frame validation, echo and deadman arming
+ * - Telemetry (telemetry.h): loop jitter, command-to-GPIO latency, distance
+ *   samples and obstacle reaction time, measured on the running robot
+ *
+ * Board pins come from the sketch (see motor_driver.h), all other hardware
+ * access goes through robot_hal.h.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include "robot_hal.h"
+#include "robot_protocol.h"
+#include "ultrasonic.h"
+#include "motor_driver.h"
+#include "telemetry.h"
+
+// ==== Control Loop Settings ====
+#define CONTROL_PERIOD_MS      20      // Control task period (50 Hz)
+#define OBSTACLE_DISTANCE_CM   5       // Emergency reverse threshold in centimeters
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+              "the mailbox and deadman state must be lock-free");
+
+// Control state of one robot
+typedef struct {
+  int buzzer_pin;                       // Obstacle alarm output
+  motor_driver_t motors;                // Motor outputs (motorInit() in the sketch's setup())
+
+  // Command mailbox: latest movement command (bits 0-7) and speed (bits 8-15)
+  std::atomic<uint32_t> mailbox;
+  std::atomic<uint32_t> posted_us;      // halMicros() of the latest post (latency measurement)
+
+  // UDP control channel state (written by the channel task, read by the
+  // control task on the other core: last_frame_ms is stored before udp_active
+  // is released, so a reader that sees the deadman armed also sees its time)
+  std::atomic<uint32_t> last_frame_ms;  // halMillis() when the last control frame arrived
+  std::atomic<bool> udp_active;         // Remote is driving over UDP (deadman armed)
+  uint16_t last_seq;                    // Last accepted sequence number
+
+  // Control task state
+  bool obstacle;                        // Obstacle state of the previous period
+  uint32_t last_step_us;                // Start of the previous period
+  uint32_t applied_post_us;             // posted_us of the last command applied
+
+  // Telemetry
+  telemetry_ring_t trace;               // Control task samples (distance, latency, obstacle events)
+  telemetry_hist_t jitter_us;           // Deviation of each period from CONTROL_PERIOD_MS
+  telemetry_hist_t command_latency_us;  // Command arrival -> motor pins
+  telemetry_counter_t obstacle_events;  // Emergency reverses started
+  telemetry_counter_t link_losses;      // Deadman stops
+  telemetry_counter_t udp_frames;       // Accepted UDP control frames
+  telemetry_counter_t udp_rejected;     // Invalid, duplicated or reordered UDP frames
+  telemetry_counter_t http_commands;    // Commands from the web interface
+} robot_control_t;
+
+/**
+ * Reset the control state (motors stopped), register its telemetry and
+ * configure the buzzer pin
+ * @param ctl - Control state
+ * @param buzzer_pin - Obstacle alarm output
+ */
+inline void controlInit(robot_control_t *ctl, int buzzer_pin) {
+  ctl->buzzer_pin = buzzer_pin;
+  ctl->mailbox.store(CONTROL_STOP);
+  ctl->posted_us.store(0);
+  ctl->last_frame_ms.store(0);
+  ctl->udp_active.store(false);
+  ctl->last_seq = 0;
+  ctl->obstacle = false;
+  ctl->last_step_us = 0;
+  ctl->applied_post_us = 0;
+  telemetryAddRing(&ctl->trace, "control");
+  telemetryAddHistogram(&ctl->jitter_us, "control_jitter_us");
+  telemetryAddHistogram(&ctl->command_latency_us, "command_latency_us");
+  telemetryAddCounter(&ctl->obstacle_events, "obstacle_events");
+  telemetryAddCounter(&ctl->link_losses, "link_losses");
+  telemetryAddCounter(&ctl->udp_frames, "udp_frames");
+  telemetryAddCounter(&ctl->udp_rejected, "udp_rejected");
+  telemetryAddCounter(&ctl->http_commands, "http_commands");
+  halGpioOutput(buzzer_pin);
+}
+
+/**
+ * Post a movement command for the control task (safe from any task)
+ * @param ctl - Control state
+ * @param cmd - Movement command (control_command_t)
+ * @param speed - Speed 0-255
+ */
+inline void postCommand(robot_control_t *ctl, uint8_t cmd, uint8_t speed) {
+  // Timestamp first: a reader that sees the new command also sees this time
+  // (or a newer one, which only under-reports the latency)
+  ctl->posted_us.store(halMicros(), std::memory_order_relaxed);
+  ctl->mailbox.store(cmd | (speed << 8), std::memory_order_release);
+}
+
+/**
+ * Run one control period: deadman, obstacle check and motor outputs
+ * @param ctl - Control state
+ * @param sensor - Ultrasonic sensor serviced in this period
+ */
+inline void controlStep(robot_control_t *ctl, ultrasonic_t *sensor) {
+  uint32_t now_us = halMicros();
+
+  // Loop jitter: deviation of this period from the nominal period
+  if (ctl->last_step_us != 0) {
+    int32_t deviation = (int32_t)(now_us - ctl->last_step_us) - CONTROL_PERIOD_MS * 1000;
+    telemetryObserve(&ctl->jitter_us, deviation < 0 ? -deviation : deviation);
+  }
+  ctl->last_step_us = now_us;
+
+  // Deadman: stop when the remote's command stream stops arriving
+  if (ctl->udp_active.load(std::memory_order_acquire) &&
+      halMillis() - ctl->last_frame_ms.load(std::memory_order_relaxed) > CONTROL_DEADMAN_MS) {
+    ctl->udp_active.store(false, std::memory_order_relaxed);
+    postCommand(ctl, CONTROL_STOP, 0);
+    telemetryCount(&ctl->link_losses);
+    telemetryTrace(&ctl->trace, TRACE_LINK_LOST, 0);
+  }
+
+  // ==== Obstacle Detection using Ultrasonic Sensor ====
+  uint32_t last_sample_us = sensor->sample_us;
+  ultrasonicPoll(sensor);
+  if (sensor->sample_us != last_sample_us) {
+    telemetryTrace(&ctl->trace, TRACE_DISTANCE_CM, sensor->distance_cm);
+  }
+
+  if (sensor->distance_cm <= OBSTACLE_DISTANCE_CM) {
+    // Obstacle detected - sound alarm and reverse both motors
+    halGpioWrite(ctl->buzzer_pin, true);
+    applyMotorCommand(&ctl->motors, CONTROL_BACK, 255);
+
+    if (!ctl->obstacle) {
+      telemetryCount(&ctl->obstacle_events);
+      telemetryTrace(&ctl->trace, TRACE_OBSTACLE_REACTION_US, halMicros() - sensor->sample_us);
+    }
+    ctl->obstacle = true;
+  } else {
+    // No obstacle - turn off buzzer and execute the latest posted command
+    halGpioWrite(ctl->buzzer_pin, false);
+    uint32_t posted = ctl->mailbox.load(std::memory_order_acquire);
+    uint32_t posted_us = ctl->posted_us.load(std::memory_order_relaxed);
+    applyMotorCommand(&ctl->motors, posted & 0xFF, posted >> 8);
+
+    if (posted_us != ctl->applied_post_us) {
+      // First time this post reaches the pins: record post -> GPIO latency
+      uint32_t latency = halMicros() - posted_us;
+      telemetryObserve(&ctl->command_latency_us, latency);
+      telemetryTrace(&ctl->trace, TRACE_COMMAND_LATENCY_US, latency);
+      ctl->applied_post_us = posted_us;
+    }
+    ctl->obstacle = false;
+  }
+}
+
+/**
+ * Handle one received UDP control frame
+ * Drops duplicated or reordered frames (any sequence is accepted after a link
+ * loss), posts the command and re-arms the deadman
+ * @param ctl - Control state
+ * @param frame - Decoded frame
+ * @return true if the command was accepted
+ */
+inline bool acceptControlFrame(robot_control_t *ctl, const control_frame_t *frame) {
+  if (ctl->udp_active.load(std::memory_order_relaxed) && !isNewerSequence(frame->seq, ctl->last_seq)) {
+    telemetryCount(&ctl->udp_rejected);
+    return false;
+  }
+  ctl->last_seq = frame->seq;
+  telemetryCount(&ctl->udp_frames);
+
+  postCommand(ctl, frame->command, frame->speed);
+  ctl->last_frame_ms.store(halMillis(), std::memory_order_relaxed);
+  ctl->udp_active.store(true, std::memory_order_release);
+  return true;
+}
+
+/**
+ * Serve the UDP control channel (never returns)
+ * Receives binary command frames from the remote (see robot_protocol.h) and
+ * echoes each valid one back for round-trip measurement
+ * @param ctl - Control state
+ * @param sock - Socket bound to CONTROL_UDP_PORT (halUdpOpen)
+ */
+inline void controlChannelLoop(robot_control_t *ctl, int sock) {
+  for (;;) {
+    uint8_t buf[CONTROL_FRAME_SIZE * 2];
+    hal_udp_peer_t from;
+    int len = halUdpReceive(sock, buf, sizeof(buf), &from);
+
+    control_frame_t frame;
+    if (len <= 0 || !decodeControlFrame(buf, len, &frame)) {
+      telemetryCount(&ctl->udp_rejected);
+      continue;                         // Not a valid control frame
+    }
+
+    // Echo the frame so the remote can measure round-trip time
+    halUdpSend(sock, buf, CONTROL_FRAME_SIZE, &from);
+    acceptControlFrame(ctl, &frame);
+  }
+}
+
+/**
+ * Hand control back to the web interface (disarms the remote's deadman)
+ * @param ctl - Control state
+ */
+inline void releaseRemoteControl(robot_control_t *ctl) {
+  ctl->udp_active.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Map a web interface URI (/go, /back, /left, /right, /stop) to a command
+ * @param uri - Request URI, may include a query string
+ * @param cmd - Parsed command (only valid when true is returned)
+ * @return true if the URI names a movement command
+ */
+inline bool parseCommandUri(const char *uri, uint8_t *cmd) {
+  for (uint8_t c = 0; c < CONTROL_COMMAND_COUNT; c++) {
+    const char *name = controlCommandName(c);
+    size_t len = strlen(name);
+    if (uri[0] == '/' && strncmp(uri + 1, name, len) == 0 && (uri[len + 1] == '\0' || uri[len + 1] == '?')) {
+      *cmd = c;
+      return true;
+    }
+  }
+  return false;
+}
+
@@ -0,0 +1,208 @@
+/**
+ * Hardware abstraction layer used by the robot core
+ *
+ * The control, sensing and protocol logic in robot_core/ only talks to the
+ * hardware through these functions, so it does not depend on the Arduino
+ * core. Each platform provides the definitions once per program:
+ *   robot_hal_esp32.h - ESP32 Arduino core (GPIO registers, LEDC, lwIP)
+ *   robot_hal_esp32_camera.h - ESP32-CAM camera (esp32-camera driver)
+ *   robot_hal_linux.h - Linux simulator (simulated clock, GPIO recorder,
+ *                       loopback UDP, I2C recorder, mock camera)
+ *
+ * A program only needs definitions for the functions it uses (the robot
+ * without camera never calls the camera functions).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Force inlining for helpers called from interrupt handlers, so they end up
+// in the handler's IRAM section instead of a flash-resident function
+#define ROBOT_ISR_INLINE inline __attribute__((always_inline))
+
+// ==== Timers ====
+
+/**
+ * Microseconds since boot (wraps after ~71 minutes, compare with subtraction)
+ * @return Time in microseconds
+ */
+uint32_t halMicros();
+
+/**
+ * Milliseconds since boot
+ * @return Time in milliseconds
+ */
+uint32_t halMillis();
+
+/**
+ * Busy-wait for a short time (trigger pulses)
+ * @param us - Delay in microseconds
+ */
+void halDelayMicros(uint32_t us);
+
+// ==== Critical Sections ====
+
+/**
+ * Enter the critical section guarding state shared between tasks (both
+ * cores). Keep it short and call no drivers inside; it may be nested.
+ */
+void halEnterCritical();
+
+/**
+ * Leave the critical section entered with halEnterCritical()
+ */
+void halExitCritical();
+
+// ==== GPIO ====
+
+/**
+ * Configure a pin as output and drive it LOW
+ * @param pin - GPIO number
+ */
+void halGpioOutput(int pin);
+
+/**
+ * Configure a pin as input
+ * @param pin - GPIO number
+ */
+void halGpioInput(int pin);
+
+/**
+ * Drive one output pin
+ * @param pin - GPIO number
+ * @param level - true = HIGH, false = LOW
+ */
+void halGpioWrite(int pin, bool level);
+
+/**
+ * Change several outputs of GPIO0-31 at once: clear first, then set
+ * @param clear_mask - Pins driven LOW
+ * @param set_mask - Pins driven HIGH
+ */
+void halGpioWriteMask(uint32_t clear_mask, uint32_t set_mask);
+
+/**
+ * Attach a PWM generator to a pin
+ * @param pin - GPIO number
+ * @param freq_hz - PWM frequency
+ * @param bits - Duty resolution in bits
+ */
+void halPwmAttach(int pin, uint32_t freq_hz, uint8_t bits);
+
+/**
+ * Set the PWM duty of a pin attached with halPwmAttach()
+ * @param pin - GPIO number
+ * @param duty - Duty cycle (0 = off)
+ */
+void halPwmWrite(int pin, uint32_t duty);
+
+// ==== Sockets (UDP, IPv4) ====
+
+// Address of a UDP peer
+typedef struct {
+  uint32_t ip;                          // IPv4 address (network byte order)
+  uint16_t port;                        // Port (host byte order)
+} hal_udp_peer_t;
+
+/**
+ * Open a UDP socket bound to a local port
+ * @param port - Local port
+ * @return Socket handle, or -1 on failure
+ */
+int halUdpOpen(uint16_t port);
+
+/**
+ * Wait for one datagram
+ * @param sock - Socket from halUdpOpen()
+ * @param buf - Receive buffer
+ * @param len - Buffer size
+ * @param from - Sender address
+ * @return Number of bytes received, <= 0 on error
+ */
+int halUdpReceive(int sock, uint8_t *buf, size_t len, hal_udp_peer_t *from);
+
+/**
+ * Send one datagram
+ * @param sock - Socket from halUdpOpen()
+ * @param buf - Bytes to send
+ * @param len - Number of bytes
+ * @param to - Destination address
+ */
+void halUdpSend(int sock, const uint8_t *buf, size_t len, const hal_udp_peer_t *to);
+
+// ==== Camera (JPEG frames) ====
+
+// Frame sizes used by the robots
+typedef enum {
+  HAL_FRAMESIZE_96X96,                  // 96x96
+  HAL_FRAMESIZE_QQVGA,                  // 160x120
+  HAL_FRAMESIZE_QVGA,                   // 320x240
+} hal_frame_size_t;
+
+// One JPEG frame lent by the camera driver
+typedef struct {
+  const uint8_t *data;                  // JPEG bytes
+  size_t len;                           // Number of bytes
+  void *handle;                         // Driver buffer (camera_fb_t on the ESP32)
+} hal_frame_t;
+
+/**
+ * Start the camera
+ * @param fb_count - Frame buffers wanted (fewer may be allocated)
+ * @param size - Initial frame size
+ * @param jpeg_quality - Initial JPEG quality (0-63, lower = better quality)
+ * @return Number of frame buffers allocated, 0 if the camera failed
+ */
+int halCameraInit(int fb_count, hal_frame_size_t size, uint8_t jpeg_quality);
+
+/**
+ * Borrow the newest frame from the driver
+ * @param frame - Receives the frame
+ * @return false if no frame could be captured
+ */
+bool halCameraGrab(hal_frame_t *frame);
+
+/**
+ * Give a frame buffer back to the driver
+ * @param frame - Frame from halCameraGrab()
+ */
+void halCameraReturn(hal_frame_t *frame);
+
+/**
+ * Change frame size and JPEG quality of the following captures
+ * @param size - Frame size
+ * @param jpeg_quality - JPEG quality (0-63, lower = better quality)
+ */
+void halCameraSetLevel(hal_frame_size_t size, uint8_t jpeg_quality);
+
+// ==== I2C (master) ====
+#define HAL_I2C_MAX_READ  128   // Longest halI2cRead() (ESP32 Wire buffer)
+
+/**
+ * Start the I2C bus
+ * @param sda_pin - Data pin
+ * @param scl_pin - Clock pin
+ * @param freq_hz - Bus clock
+ * @return false if the bus could not be started
+ */
+bool halI2cBegin(int sda_pin, int scl_pin, uint32_t freq_hz);
+
+/**
+ * Write bytes to a device in one transaction
+ * @param addr - 7-bit device address
+ * @param data - Bytes to write
+ * @param len - Number of bytes
+ * @return false if the device did not acknowledge
+ */
+bool halI2cWrite(uint8_t addr, const uint8_t *data, size_t len);
+
+/**
+ * Read bytes starting at a device register (write register, repeated start, read)
+ * @param addr - 7-bit device address
+ * @param reg - First register
+ * @param data - Receives the bytes
+ * @param len - Number of bytes (at most HAL_I2C_MAX_READ)
+ * @return false if the device did not answer
+ */
+bool halI2cRead(uint8_t addr, uint8_t reg, uint8_t *data, size_t len);
@@ -0,0 +1,128 @@
+/**
+ * ESP32 (Arduino core 3.x) implementation of robot_hal.h
+ *
+ * Contains the function definitions, so include it from exactly one file of
+ * the sketch (the .C file itself).
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "soc/gpio_struct.h"
+#include "lwip/sockets.h"
+#include "robot_hal.h"
+
+// ==== Timers ====
+
+uint32_t halMicros() {
+  return micros();
+}
+
+uint32_t halMillis() {
+  return millis();
+}
+
+void halDelayMicros(uint32_t us) {
+  delayMicroseconds(us);
+}
+
+// ==== Critical Sections ====
+
+portMUX_TYPE hal_critical_lock = portMUX_INITIALIZER_UNLOCKED;  // Spinlock, also holds off the other core
+
+void halEnterCritical() {
+  portENTER_CRITICAL(&hal_critical_lock);
+}
+
+void halExitCritical() {
+  portEXIT_CRITICAL(&hal_critical_lock);
+}
+
+// ==== GPIO ====
+
+void halGpioOutput(int pin) {
+  pinMode(pin, OUTPUT);
+  digitalWrite(pin, LOW);
+}
+
+void halGpioInput(int pin) {
+  pinMode(pin, INPUT);
+}
+
+void halGpioWrite(int pin, bool level) {
+  digitalWrite(pin, level ? HIGH : LOW);
+}
+
+void halGpioWriteMask(uint32_t clear_mask, uint32_t set_mask) {
+  // Write-1-to-clear / write-1-to-set registers: no read-modify-write
+  GPIO.out_w1tc = clear_mask;
+  GPIO.out_w1ts = set_mask;
+}
+
+void halPwmAttach(int pin, uint32_t freq_hz, uint8_t bits) {
+  ledcAttach(pin, freq_hz, bits);
+}
+
+void halPwmWrite(int pin, uint32_t duty) {
+  ledcWrite(pin, duty);
+}
+
+// ==== Sockets (lwIP) ====
+
+int halUdpOpen(uint16_t port) {
+  int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+  if (sock < 0) {
+    return -1;
+  }
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(sock);
+    return -1;
+  }
+  return sock;
+}
+
+int halUdpReceive(int sock, uint8_t *buf, size_t len, hal_udp_peer_t *from) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int received = recvfrom(sock, buf, len, 0, (struct sockaddr *)&addr, &addr_len);
+  from->ip = addr.sin_addr.s_addr;
+  from->port = ntohs(addr.sin_port);
+  return received;
+}
+
+void halUdpSend(int sock, const uint8_t *buf, size_t len, const hal_udp_peer_t *to) {
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(to->port);
+  addr.sin_addr.s_addr = to->ip;
+  sendto(sock, buf, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+}
+
+// ==== I2C (Wire) ====
+
+bool halI2cBegin(int sda_pin, int scl_pin, uint32_t freq_hz) {
+  return Wire.begin(sda_pin, scl_pin, freq_hz);
+}
+
+bool halI2cWrite(uint8_t addr, const uint8_t *data, size_t len) {
+  Wire.beginTransmission(addr);
+  Wire.write(data, len);
+  return Wire.endTransmission() == 0;
+}
+
+bool halI2cRead(uint8_t addr, uint8_t reg, uint8_t *data, size_t len) {
+  Wire.beginTransmission(addr);
+  Wire.write(reg);
+  if (Wire.endTransmission(false) != 0) {  // Repeated start, keep the bus
+    return false;
+  }
+  if (Wire.requestFrom((uint16_t)addr, len, true) != len) {
+    return false;
+  }
+  Wire.readBytes(data, len);
+  return true;
+}
@@ -0,0 +1,106 @@
+/**
+ * ESP32-CAM camera functions of robot_hal.h (esp32-camera driver)
+ *
+ * The camera pins are compile-time settings: define PWDN_GPIO_NUM,
+ * RESET_GPIO_NUM, XCLK_GPIO_NUM, SIOD_GPIO_NUM, SIOC_GPIO_NUM, Y2_GPIO_NUM to
+ * Y9_GPIO_NUM, VSYNC_GPIO_NUM, HREF_GPIO_NUM and PCLK_GPIO_NUM before
+ * including this header.
+ *
+ * Contains the function definitions, so include it from exactly one file of
+ * the sketch (the .C file itself).
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "esp_camera.h"
+#include "robot_hal.h"
+
+#if !defined(PWDN_GPIO_NUM) || !defined(RESET_GPIO_NUM) || !defined(XCLK_GPIO_NUM) || !defined(SIOD_GPIO_NUM) || \
+    !defined(SIOC_GPIO_NUM) || !defined(Y2_GPIO_NUM) || !defined(Y9_GPIO_NUM) || !defined(VSYNC_GPIO_NUM) || \
+    !defined(HREF_GPIO_NUM) || !defined(PCLK_GPIO_NUM)
+#error "Define the camera *_GPIO_NUM pins before including robot_hal_esp32_camera.h"
+#endif
+
+/**
+ * Driver frame size of a HAL frame size
+ * @param size - HAL frame size
+ * @return esp32-camera frame size
+ */
+inline framesize_t halDriverFrameSize(hal_frame_size_t size) {
+  switch (size) {
+    case HAL_FRAMESIZE_96X96: return FRAMESIZE_96X96;
+    case HAL_FRAMESIZE_QVGA:  return FRAMESIZE_QVGA;
+    default:                  return FRAMESIZE_QQVGA;
+  }
+}
+
+int halCameraInit(int fb_count, hal_frame_size_t size, uint8_t jpeg_quality) {
+  camera_config_t config = {};
+
+  // Configure camera hardware settings
+  config.ledc_channel = LEDC_CHANNEL_0;     // LED PWM channel for camera clock
+  config.ledc_timer = LEDC_TIMER_0;         // LED PWM timer for camera clock
+
+  // Assign camera data pins (8-bit parallel interface)
+  config.pin_d0 = Y2_GPIO_NUM;              // Data bit 0 (LSB)
+  config.pin_d1 = Y3_GPIO_NUM;              // Data bit 1
+  config.pin_d2 = Y4_GPIO_NUM;              // Data bit 2
+  config.pin_d3 = Y5_GPIO_NUM;              // Data bit 3
+  config.pin_d4 = Y6_GPIO_NUM;              // Data bit 4
+  config.pin_d5 = Y7_GPIO_NUM;              // Data bit 5
+  config.pin_d6 = Y8_GPIO_NUM;              // Data bit 6
+  config.pin_d7 = Y9_GPIO_NUM;              // Data bit 7 (MSB)
+
+  // Assign camera control pins
+  config.pin_xclk = XCLK_GPIO_NUM;          // External clock pin
+  config.pin_pclk = PCLK_GPIO_NUM;          // Pixel clock pin
+  config.pin_vsync = VSYNC_GPIO_NUM;        // Vertical sync pin
+  config.pin_href = HREF_GPIO_NUM;          // Horizontal reference pin
+  config.pin_sccb_sda = SIOD_GPIO_NUM;      // I2C data pin (SCCB protocol)
+  config.pin_sccb_scl = SIOC_GPIO_NUM;      // I2C clock pin (SCCB protocol)
+  config.pin_pwdn = PWDN_GPIO_NUM;          // Power down control pin
+  config.pin_reset = RESET_GPIO_NUM;        // Reset pin (not used)
+
+  // Camera timing and quality settings
+  config.xclk_freq_hz = 20000000;           // 20MHz external clock frequency
+  config.pixel_format = PIXFORMAT_JPEG;     // Output format: JPEG compression
+  config.frame_size = halDriverFrameSize(size);
+  config.jpeg_quality = jpeg_quality;       // JPEG quality (0-63, lower = better quality)
+  if (psramFound()) {
+    config.fb_count = fb_count;             // Ring of frame buffers: capture while viewers send
+    config.fb_location = CAMERA_FB_IN_PSRAM;  // Frame buffers in external PSRAM
+    config.grab_mode = CAMERA_GRAB_LATEST;  // Always hand out the newest frame
+  } else {
+    config.fb_count = 1;                    // No PSRAM: single buffer in DRAM
+    config.fb_location = CAMERA_FB_IN_DRAM;
+    config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
+  }
+
+  esp_err_t err = esp_camera_init(&config);
+  if (err != ESP_OK) {
+    Serial.printf("Camera initialization failed: 0x%x\n", err);
+    return 0;
+  }
+  return config.fb_count;
+}
+
+bool halCameraGrab(hal_frame_t *frame) {
+  camera_fb_t *fb = esp_camera_fb_get();
+  if (!fb) {
+    return false;
+  }
+  frame->data = fb->buf;
+  frame->len = fb->len;
+  frame->handle = fb;
+  return true;
+}
+
+void halCameraReturn(hal_frame_t *frame) {
+  esp_camera_fb_return((camera_fb_t *)frame->handle);
+}
+
+void halCameraSetLevel(hal_frame_size_t size, uint8_t jpeg_quality) {
+  sensor_t *s = esp_camera_sensor_get();
+  s->set_framesize(s, halDriverFrameSize(size));
+  s->set_quality(s, jpeg_quality);
+}
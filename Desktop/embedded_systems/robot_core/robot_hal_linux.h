@@ -0,0 +1,501 @@
+/**
+ * Linux implementation of robot_hal.h for the host build (simulator, tests
+ * and benchmarks)
+ *
+ * - Clock: simulated by default. Time only moves when the program calls
+ *   simAdvance() or halDelayMicros(), so runs are fast and repeatable.
+ *   simRealTime(true) switches to the monotonic clock for measurements across
+ *   threads.
+ * - Events: callbacks scheduled on the simulated clock stand in for
+ *   interrupts (e.g. echo edges of the simulated HC-SR04)
+ * - GPIO: output levels and PWM duty kept in memory. Every register write is
+ *   recorded with its time, and hooks see each write as it happens
+ * - UDP: real sockets on the loopback interface
+ * - I2C: device models registered per address; every write is counted and
+ *   the bus time is added to the simulated clock
+ * - Camera: mock driver lending synthetic JPEG frames from a fixed set of
+ *   buffers, so buffer leaks and double returns show up
+ *
+ * Contains the function definitions, so include it from exactly one file of
+ * each program.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <mutex>
+#include "robot_hal.h"
+
+// ==== Simulator Settings ====
+#define SIM_START_US     1000000  // Simulated time at program start (setup() has run)
+#define SIM_GPIO_COUNT   40       // GPIO0-39 like the ESP32
+#define SIM_EVENT_SLOTS  32       // Pending events
+#define SIM_GPIO_HOOKS   4        // Registered GPIO hooks
+#define SIM_GPIO_LOG     256      // GPIO writes kept by the recorder (power of two)
+#define SIM_CAMERA_FB    8        // Frame buffers of the mock camera
+#define SIM_CAMERA_JPEG  20000    // Largest synthetic JPEG in bytes
+static_assert((SIM_GPIO_LOG & (SIM_GPIO_LOG - 1)) == 0, "SIM_GPIO_LOG must be a power of two");
+
+// Event callback, runs on the simulated clock like an interrupt handler
+typedef void (*sim_event_fn_t)(void *ctx);
+
+// GPIO hook, called for every output write (a single pin write is a one-bit mask)
+typedef void (*sim_gpio_hook_t)(void *ctx, uint64_t clear_mask, uint64_t set_mask);
+
+// Scheduled event
+typedef struct {
+  uint64_t at_us;                       // Simulated time to run at
+  sim_event_fn_t fn;                    // Callback (NULL = slot free)
+  void *ctx;                            // Callback argument
+} sim_event_t;
+
+// One recorded GPIO register write
+typedef struct {
+  uint64_t time_us;                     // halMicros() of the write (64 bit, no wrap)
+  uint64_t clear_mask;                  // Pins driven LOW
+  uint64_t set_mask;                    // Pins driven HIGH
+} sim_gpio_write_t;
+
+// Simulated I2C device
+typedef struct {
+  bool (*write)(void *ctx, const uint8_t *data, size_t len);              // Write transaction
+  bool (*read)(void *ctx, uint8_t reg, uint8_t *data, size_t len);        // Register read
+  void *ctx;                                                              // Callback argument
+} sim_i2c_device_t;
+
+// Mock camera
+typedef struct {
+  int fb_count;                         // Buffers allocated by halCameraInit() (0 = not started)
+  bool psram = true;                    // false = single buffer like an ESP32-CAM without PSRAM
+  hal_frame_size_t size;                // Current frame size
+  uint8_t jpeg_quality;                 // Current JPEG quality
+  uint32_t capture_us;                  // Time one capture takes on the simulated clock
+  bool lent[SIM_CAMERA_FB];             // Buffer handed out by halCameraGrab()
+  uint8_t buffers[SIM_CAMERA_FB][SIM_CAMERA_JPEG];
+  uint32_t frames;                      // Frames captured
+  int lent_count;                       // Buffers currently handed out
+  int max_lent;                         // Most buffers handed out at once
+  uint32_t bad_returns;                 // Returns of buffers that were not lent
+  std::mutex lock;                      // Grab and return may run on different threads
+} sim_camera_t;
+
+// ==== Simulator State ====
+std::atomic<uint64_t> sim_now_us{SIM_START_US};  // Simulated time
+std::atomic<bool> sim_real_time{false};          // halMicros() follows CLOCK_MONOTONIC
+uint64_t sim_real_offset_us = 0;                  // Monotonic clock -> simulated time
+sim_event_t sim_events[SIM_EVENT_SLOTS];
+
+std::atomic<uint64_t> sim_gpio_levels{0};         // Output levels, one bit per pin
+uint32_t sim_pwm_duty[SIM_GPIO_COUNT];            // PWM duty per pin
+sim_gpio_hook_t sim_gpio_hooks[SIM_GPIO_HOOKS];
+void *sim_gpio_hook_ctx[SIM_GPIO_HOOKS];
+sim_gpio_write_t sim_gpio_log[SIM_GPIO_LOG];      // Recorder ring
+std::atomic<uint32_t> sim_gpio_writes{0};         // GPIO writes since the last simReset()
+
+sim_i2c_device_t *sim_i2c_devices[128];            // Device model per 7-bit address
+uint32_t sim_i2c_freq_hz = 100000;                 // Bus clock from halI2cBegin()
+uint32_t sim_i2c_transactions = 0;                 // Acknowledged transactions
+uint32_t sim_i2c_bytes = 0;                        // Bytes on the bus, address bytes included
+
+sim_camera_t sim_camera;                           // The mock camera
+std::recursive_mutex sim_critical_lock;            // halEnterCritical() (nests like a portMUX)
+
+// ==== Simulator Control ====
+
+/**
+ * Monotonic clock of the host
+ * @return Time in microseconds
+ */
+inline uint64_t simMonotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Current time of the simulation (64 bit, halMicros() is the low half)
+ * @return Time in microseconds
+ */
+inline uint64_t simNow() {
+  if (sim_real_time.load(std::memory_order_relaxed)) {
+    return simMonotonicUs() + sim_real_offset_us;
+  }
+  return sim_now_us.load(std::memory_order_relaxed);
+}
+
+/**
+ * Switch between the simulated and the real (monotonic) clock
+ * Time continues from its current value either way
+ * @param on - true = real time
+ */
+inline void simRealTime(bool on) {
+  uint64_t now = simNow();
+  if (on) {
+    sim_real_offset_us = now - simMonotonicUs();
+  } else {
+    sim_now_us.store(now);
+  }
+  sim_real_time.store(on);
+}
+
+/**
+ * Schedule a callback on the simulated clock
+ * @param delay_us - Delay from now
+ * @param fn - Callback
+ * @param ctx - Callback argument
+ * @return false if all event slots are taken
+ */
+inline bool simSchedule(uint32_t delay_us, sim_event_fn_t fn, void *ctx) {
+  for (int i = 0; i < SIM_EVENT_SLOTS; i++) {
+    if (sim_events[i].fn == NULL) {
+      sim_events[i] = { simNow() + delay_us, fn, ctx };
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Advance the simulated clock, running due events in time order
+ * Events may schedule further events, which also run if they fall due
+ * @param us - Time to advance in microseconds
+ */
+inline void simAdvance(uint64_t us) {
+  uint64_t target = sim_now_us.load() + us;
+  for (;;) {
+    int next = -1;
+    for (int i = 0; i < SIM_EVENT_SLOTS; i++) {
+      if (sim_events[i].fn && sim_events[i].at_us <= target &&
+          (next < 0 || sim_events[i].at_us < sim_events[next].at_us)) {
+        next = i;
+      }
+    }
+    if (next < 0) {
+      break;
+    }
+    sim_event_t event = sim_events[next];
+    sim_events[next].fn = NULL;
+    if (event.at_us > sim_now_us.load()) {
+      sim_now_us.store(event.at_us);
+    }
+    event.fn(event.ctx);
+  }
+  sim_now_us.store(target);
+}
+
+/**
+ * Register a GPIO hook (sees every output write)
+ * @param hook - Callback
+ * @param ctx - Callback argument
+ * @return false if all hook slots are taken
+ */
+inline bool simAddGpioHook(sim_gpio_hook_t hook, void *ctx) {
+  for (int i = 0; i < SIM_GPIO_HOOKS; i++) {
+    if (sim_gpio_hooks[i] == NULL) {
+      sim_gpio_hooks[i] = hook;
+      sim_gpio_hook_ctx[i] = ctx;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Output level of a pin
+ * @param pin - GPIO number
+ * @return true = HIGH
+ */
+inline bool simGpioLevel(int pin) {
+  return (sim_gpio_levels.load(std::memory_order_relaxed) >> pin) & 1;
+}
+
+/**
+ * PWM duty of a pin
+ * @param pin - GPIO number
+ * @return Duty written with halPwmWrite()
+ */
+inline uint32_t simPwmDuty(int pin) {
+  return sim_pwm_duty[pin];
+}
+
+/**
+ * Recorded GPIO write, counted back from the newest one
+ * @param age - 0 = newest write, must be below SIM_GPIO_LOG and sim_gpio_writes
+ * @return Recorded write
+ */
+inline const sim_gpio_write_t *simGpioLog(uint32_t age) {
+  return &sim_gpio_log[(sim_gpio_writes.load() - 1 - age) & (SIM_GPIO_LOG - 1)];
+}
+
+/**
+ * Back to the initial state: simulated clock at SIM_START_US, no events,
+ * all pins LOW, no hooks, empty recorder
+ */
+inline void simReset() {
+  sim_real_time.store(false);
+  sim_now_us.store(SIM_START_US);
+  memset(sim_events, 0, sizeof(sim_events));
+  sim_gpio_levels.store(0);
+  memset(sim_pwm_duty, 0, sizeof(sim_pwm_duty));
+  memset(sim_gpio_hooks, 0, sizeof(sim_gpio_hooks));
+  sim_gpio_writes.store(0);
+  memset(sim_i2c_devices, 0, sizeof(sim_i2c_devices));
+  sim_i2c_freq_hz = 100000;
+  sim_i2c_transactions = 0;
+  sim_i2c_bytes = 0;
+  sim_camera.fb_count = 0;
+  sim_camera.psram = true;
+  sim_camera.capture_us = 0;
+  memset(sim_camera.lent, 0, sizeof(sim_camera.lent));
+  sim_camera.frames = 0;
+  sim_camera.lent_count = 0;
+  sim_camera.max_lent = 0;
+  sim_camera.bad_returns = 0;
+}
+
+/**
+ * Attach a device model to the I2C bus
+ * @param addr - 7-bit address
+ * @param device - Device model (NULL = remove)
+ */
+inline void simAttachI2c(uint8_t addr, sim_i2c_device_t *device) {
+  sim_i2c_devices[addr & 0x7F] = device;
+}
+
+/**
+ * Count one I2C transaction and let its bus time pass (9 clocks per byte)
+ * @param bytes - Bytes on the bus including address bytes
+ */
+inline void simI2cTransfer(size_t bytes) {
+  sim_i2c_transactions++;
+  sim_i2c_bytes += bytes;
+  if (!sim_real_time.load()) {
+    simAdvance((uint64_t)bytes * 9 * 1000000 / sim_i2c_freq_hz);
+  }
+}
+
+/**
+ * Size of a synthetic JPEG: bytes per pixel fall with the quality setting,
+ * plus a few percent of frame-to-frame variation
+ * @param size - Frame size
+ * @param jpeg_quality - JPEG quality (0-63)
+ * @param frame - Frame number (variation)
+ * @return Size in bytes
+ */
+inline size_t simJpegSize(hal_frame_size_t size, uint8_t jpeg_quality, uint32_t frame) {
+  uint32_t pixels = size == HAL_FRAMESIZE_96X96 ? 96 * 96 : size == HAL_FRAMESIZE_QVGA ? 320 * 240 : 160 * 120;
+  double bytes_per_pixel = 0.25 - jpeg_quality * 0.004;
+  double variation = 1.0 + ((frame * 2654435761u) >> 28) / 200.0;   // 0 - 7.5%
+  size_t len = (size_t)(pixels * bytes_per_pixel * variation);
+  return len < SIM_CAMERA_JPEG ? len : SIM_CAMERA_JPEG;
+}
+
+/**
+ * Apply and record one GPIO register write
+ * @param clear_mask - Pins driven LOW
+ * @param set_mask - Pins driven HIGH
+ */
+inline void simGpioWrite(uint64_t clear_mask, uint64_t set_mask) {
+  uint64_t levels = sim_gpio_levels.load(std::memory_order_relaxed);
+  sim_gpio_levels.store((levels & ~clear_mask) | set_mask, std::memory_order_relaxed);
+
+  uint32_t n = sim_gpio_writes.load(std::memory_order_relaxed);
+  sim_gpio_log[n & (SIM_GPIO_LOG - 1)] = { simNow(), clear_mask, set_mask };
+  sim_gpio_writes.store(n + 1, std::memory_order_release);
+
+  for (int i = 0; i < SIM_GPIO_HOOKS; i++) {
+    if (sim_gpio_hooks[i]) {
+      sim_gpio_hooks[i](sim_gpio_hook_ctx[i], clear_mask, set_mask);
+    }
+  }
+}
+
+// ==== Timers ====
+
+uint32_t halMicros() {
+  return (uint32_t)simNow();
+}
+
+uint32_t halMillis() {
+  return (uint32_t)(simNow() / 1000);
+}
+
+void halDelayMicros(uint32_t us) {
+  if (sim_real_time.load()) {
+    uint64_t end = simMonotonicUs() + us;
+    while (simMonotonicUs() < end) {
+    }
+  } else {
+    simAdvance(us);
+  }
+}
+
+// ==== Critical Sections ====
+
+void halEnterCritical() {
+  sim_critical_lock.lock();
+}
+
+void halExitCritical() {
+  sim_critical_lock.unlock();
+}
+
+// ==== GPIO ====
+
+void halGpioOutput(int pin) {
+  simGpioWrite(1ULL << pin, 0);
+}
+
+void halGpioInput(int pin) {
+  (void)pin;                            // Inputs are driven by the simulation models
+}
+
+void halGpioWrite(int pin, bool level) {
+  simGpioWrite(level ? 0 : 1ULL << pin, level ? 1ULL << pin : 0);
+}
+
+void halGpioWriteMask(uint32_t clear_mask, uint32_t set_mask) {
+  simGpioWrite(clear_mask, set_mask);
+}
+
+void halPwmAttach(int pin, uint32_t freq_hz, uint8_t bits) {
+  (void)freq_hz;
+  (void)bits;
+  sim_pwm_duty[pin] = 0;
+}
+
+void halPwmWrite(int pin, uint32_t duty) {
+  sim_pwm_duty[pin] = duty;
+}
+
+// ==== Sockets (loopback) ====
+
+int halUdpOpen(uint16_t port) {
+  int sock = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock < 0) {
+    return -1;
+  }
+  int reuse = 1;
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(sock);
+    return -1;
+  }
+  return sock;
+}
+
+int halUdpReceive(int sock, uint8_t *buf, size_t len, hal_udp_peer_t *from) {
+  struct sockaddr_in addr = {};
+  socklen_t addr_len = sizeof(addr);
+  int received = recvfrom(sock, buf, len, 0, (struct sockaddr *)&addr, &addr_len);
+  from->ip = addr.sin_addr.s_addr;
+  from->port = ntohs(addr.sin_port);
+  return received;
+}
+
+void halUdpSend(int sock, const uint8_t *buf, size_t len, const hal_udp_peer_t *to) {
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(to->port);
+  addr.sin_addr.s_addr = to->ip;
+  sendto(sock, buf, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+}
+
+// ==== Camera (mock) ====
+
+int halCameraInit(int fb_count, hal_frame_size_t size, uint8_t jpeg_quality) {
+  std::lock_guard<std::mutex> guard(sim_camera.lock);
+  if (!sim_camera.psram) {
+    fb_count = 1;                       // Like the ESP32-CAM driver without PSRAM
+  }
+  sim_camera.fb_count = fb_count < SIM_CAMERA_FB ? fb_count : SIM_CAMERA_FB;
+  sim_camera.size = size;
+  sim_camera.jpeg_quality = jpeg_quality;
+  return sim_camera.fb_count;
+}
+
+bool halCameraGrab(hal_frame_t *frame) {
+  if (sim_camera.capture_us && !sim_real_time.load()) {
+    simAdvance(sim_camera.capture_us);
+  }
+  std::lock_guard<std::mutex> guard(sim_camera.lock);
+  for (int i = 0; i < sim_camera.fb_count; i++) {
+    if (!sim_camera.lent[i]) {
+      // Synthetic JPEG: SOI marker, frame number, filler, EOI marker
+      uint32_t n = ++sim_camera.frames;
+      uint8_t *buf = sim_camera.buffers[i];
+      size_t len = simJpegSize(sim_camera.size, sim_camera.jpeg_quality, n);
+      memset(buf, (uint8_t)n, len);
+      buf[0] = 0xFF;
+      buf[1] = 0xD8;
+      memcpy(buf + 2, &n, sizeof(n));
+      buf[len - 2] = 0xFF;
+      buf[len - 1] = 0xD9;
+
+      sim_camera.lent[i] = true;
+      sim_camera.lent_count++;
+      if (sim_camera.lent_count > sim_camera.max_lent) {
+        sim_camera.max_lent = sim_camera.lent_count;
+      }
+      frame->data = buf;
+      frame->len = len;
+      frame->handle = &sim_camera.lent[i];
+      return true;
+    }
+  }
+  return false;                         // All buffers lent out: the driver has nothing to fill
+}
+
+void halCameraReturn(hal_frame_t *frame) {
+  std::lock_guard<std::mutex> guard(sim_camera.lock);
+  bool *lent = (bool *)frame->handle;
+  if (lent < sim_camera.lent || lent >= sim_camera.lent + sim_camera.fb_count || !*lent) {
+    sim_camera.bad_returns++;
+    return;
+  }
+  *lent = false;
+  sim_camera.lent_count--;
+}
+
+void halCameraSetLevel(hal_frame_size_t size, uint8_t jpeg_quality) {
+  std::lock_guard<std::mutex> guard(sim_camera.lock);
+  sim_camera.size = size;
+  sim_camera.jpeg_quality = jpeg_quality;
+}
+
+// ==== I2C (device models) ====
+
+bool halI2cBegin(int sda_pin, int scl_pin, uint32_t freq_hz) {
+  (void)sda_pin;
+  (void)scl_pin;
+  sim_i2c_freq_hz = freq_hz;
+  return true;
+}
+
+bool halI2cWrite(uint8_t addr, const uint8_t *data, size_t len) {
+  sim_i2c_device_t *device = sim_i2c_devices[addr & 0x7F];
+  if (!device || !device->write) {
+    return false;                       // Nobody acknowledged the address
+  }
+  simI2cTransfer(1 + len);
+  return device->write(device->ctx, data, len);
+}
+
+bool halI2cRead(uint8_t addr, uint8_t reg, uint8_t *data, size_t len) {
+  sim_i2c_device_t *device = sim_i2c_devices[addr & 0x7F];
+  if (!device || !device->read || len > HAL_I2C_MAX_READ) {
+    return false;
+  }
+  simI2cTransfer(1 + 1 + 1 + len);      // Address + register, repeated start address, data
+  return device->read(device->ctx, reg, data, len);
+}
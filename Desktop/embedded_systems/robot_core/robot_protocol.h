@@ -0,0 +1,126 @@
+/**
+ * Binary control protocol shared by the robots and the IMU remote
+ *
+ * The remote streams one command frame every CONTROL_SEND_PERIOD_MS over UDP.
+ * The robot echoes every valid frame back so the remote can measure the
+ * round-trip time, and stops the motors when no frame arrives for
+ * CONTROL_DEADMAN_MS.
+ *
+ * Frame layout (8 bytes, little endian):
+ *   [0]    magic (CONTROL_MAGIC)
+ *   [1]    protocol version (CONTROL_VERSION)
+ *   [2..3] sequence number (wraps around)
+ *   [4]    command (control_command_t)
+ *   [5]    speed (0-255)
+ *   [6]    reserved, always 0
+ *   [7]    CRC-8 of bytes 0..6
+ *
+ * Plain C++ without Arduino dependencies, so it also builds on a PC.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ==== Protocol Constants ====
+#define CONTROL_UDP_PORT        4210   // UDP port the robot listens on
+#define CONTROL_SEND_PERIOD_MS  50     // Remote sends a frame every 50ms (20 Hz)
+#define CONTROL_DEADMAN_MS      300    // Robot stops when no frame arrives for this long
+#define CONTROL_FRAME_SIZE      8      // Size of one encoded frame in bytes
+#define CONTROL_MAGIC           0xB7   // First byte of every frame
+#define CONTROL_VERSION         1      // Protocol version
+
+// Movement commands (values are sent on the wire)
+typedef enum {
+  CONTROL_STOP = 0,
+  CONTROL_GO,
+  CONTROL_BACK,
+  CONTROL_LEFT,
+  CONTROL_RIGHT,
+  CONTROL_COMMAND_COUNT
+} control_command_t;
+
+// Decoded command frame
+typedef struct {
+  uint16_t seq;                         // Sequence number
+  uint8_t command;                      // control_command_t value
+  uint8_t speed;                        // Requested speed (0-255)
+} control_frame_t;
+
+/**
+ * CRC-8 (polynomial 0x07) used to reject corrupted frames
+ * @param data - Bytes to check
+ * @param len - Number of bytes
+ * @return CRC-8 value
+ */
+inline uint8_t controlCrc8(const uint8_t *data, size_t len) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * Encode a command frame
+ * @param frame - Frame to encode
+ * @param buf - Output buffer of at least CONTROL_FRAME_SIZE bytes
+ * @return Number of bytes written (CONTROL_FRAME_SIZE)
+ */
+inline size_t encodeControlFrame(const control_frame_t *frame, uint8_t *buf) {
+  buf[0] = CONTROL_MAGIC;
+  buf[1] = CONTROL_VERSION;
+  buf[2] = frame->seq & 0xFF;
+  buf[3] = frame->seq >> 8;
+  buf[4] = frame->command;
+  buf[5] = frame->speed;
+  buf[6] = 0;
+  buf[7] = controlCrc8(buf, CONTROL_FRAME_SIZE - 1);
+  return CONTROL_FRAME_SIZE;
+}
+
+/**
+ * Decode and validate a received command frame
+ * @param buf - Received bytes
+ * @param len - Number of received bytes
+ * @param frame - Decoded frame (only valid when true is returned)
+ * @return true if the frame is well formed, false otherwise
+ */
+inline bool decodeControlFrame(const uint8_t *buf, size_t len, control_frame_t *frame) {
+  if (len != CONTROL_FRAME_SIZE || buf[0] != CONTROL_MAGIC || buf[1] != CONTROL_VERSION ||
+      buf[7] != controlCrc8(buf, CONTROL_FRAME_SIZE - 1) || buf[4] >= CONTROL_COMMAND_COUNT) {
+    return false;
+  }
+  frame->seq = buf[2] | (buf[3] << 8);
+  frame->command = buf[4];
+  frame->speed = buf[5];
+  return true;
+}
+
+/**
+ * Check if a sequence number is newer than the last accepted one (handles wrap-around)
+ * @param seq - Received sequence number
+ * @param last_seq - Last accepted sequence number
+ * @return true if seq comes after last_seq
+ */
+inline bool isNewerSequence(uint16_t seq, uint16_t last_seq) {
+  return (int16_t)(seq - last_seq) > 0;
+}
+
+/**
+ * Command name as used by the HTTP interface ("go", "back", "left", "right", "stop")
+ * @param command - control_command_t value
+ * @return Command name
+ */
+inline const char *controlCommandName(uint8_t command) {
+  switch (command) {
+    case CONTROL_GO:    return "go";
+    case CONTROL_BACK:  return "back";
+    case CONTROL_LEFT:  return "left";
+    case CONTROL_RIGHT: return "right";
+    default:            return "stop";
+  }
+}
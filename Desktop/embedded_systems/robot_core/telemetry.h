@@ -0,0 +1,421 @@
+/**
+ * Low-overhead runtime telemetry
+ *
+ * Three kinds of metrics, all cheap enough for the control and stream paths:
+ * - Counters / gauges: one relaxed atomic add or store
+ * - Histograms: log2 buckets (bucket i holds values up to 2^i - 1), count, sum
+ *   and maximum, safe to update from several tasks. Only 32-bit atomics are
+ *   used (64-bit ones take a lock on the ESP32), the sum carries into a
+ *   second word
+ * - Trace rings: the last TELEMETRY_RING_SIZE timestamped samples of one task.
+ *   Each ring has exactly one writing task, so recording is two plain stores
+ *   and one release store of the head index, no lock
+ *
+ * Nothing is formatted until someone reads /metrics: writeMetricsText()
+ * renders counters and histograms in the Prometheus text format,
+ * writeMetricsBinary() dumps everything including the trace rings for
+ * tools/decode_metrics.js.
+ *
+ * Metrics register themselves in global lists at startup (before the tasks
+ * that update them start) and are never removed.
+ *
+ * Plain C++ without Arduino dependencies, so it also builds on a PC.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <atomic>
+#include "robot_hal.h"
+
+// ==== Telemetry Settings ====
+#define TELEMETRY_HIST_BUCKETS  24     // Log2 buckets, the last one is open ended (>= 4.2 s in µs)
+#define TELEMETRY_RING_SIZE     128    // Samples kept per trace ring (power of two)
+#define TELEMETRY_NAME_LEN      24     // Name field size in the binary dump
+#define TELEMETRY_MAGIC         0x324D5452  // "RTM2" in the binary dump
+static_assert((TELEMETRY_RING_SIZE & (TELEMETRY_RING_SIZE - 1)) == 0, "TELEMETRY_RING_SIZE must be a power of two");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "telemetry counters must be lock-free");
+
+// Trace sample types (keep in sync with tools/decode_metrics.js)
+typedef enum {
+  TRACE_DISTANCE_CM = 1,                // Filtered ultrasonic distance
+  TRACE_COMMAND_LATENCY_US,             // Command arrival -> motor pins
+  TRACE_OBSTACLE_REACTION_US,           // Echo -> emergency reverse
+  TRACE_LINK_LOST,                      // Deadman stop (value unused)
+  TRACE_FRAME_CAPTURE_US,               // Time spent in esp_camera_fb_get()
+  TRACE_FRAME_BYTES,                    // JPEG size
+  TRACE_FRAME_SEND_US,                  // Time to send one frame to a viewer
+  TRACE_FRAMES_DROPPED,                 // Frames a viewer skipped before this one
+  TRACE_FREE_HEAP,                      // Free internal heap in bytes
+  TRACE_FREE_PSRAM,                     // Free PSRAM in bytes
+} trace_type_t;
+
+// Counter or gauge
+typedef struct telemetry_counter {
+  const char *name;
+  bool gauge;                           // Gauge (set) instead of counter (add)
+  std::atomic<uint32_t> value;
+  struct telemetry_counter *next;
+} telemetry_counter_t;
+
+// Log2 histogram
+typedef struct telemetry_hist {
+  const char *name;
+  std::atomic<uint32_t> count;          // Number of observed values
+  std::atomic<uint32_t> sum_low;        // Sum of the observed values (Prometheus _sum), low word
+  std::atomic<uint32_t> sum_high;       // Carries out of sum_low
+  std::atomic<uint32_t> max;            // Largest observed value
+  std::atomic<uint32_t> buckets[TELEMETRY_HIST_BUCKETS];
+  struct telemetry_hist *next;
+} telemetry_hist_t;
+
+// One trace sample
+typedef struct {
+  uint32_t time_us;                     // halMicros() when recorded
+  uint32_t word;                        // Type (bits 24-31) and value (bits 0-23, saturated)
+} trace_entry_t;
+
+// Single-writer trace ring
+typedef struct telemetry_ring {
+  const char *name;
+  std::atomic<uint32_t> head;           // Number of samples ever written
+  trace_entry_t entries[TELEMETRY_RING_SIZE];
+  struct telemetry_ring *next;
+} telemetry_ring_t;
+
+// Registered metrics (filled at startup, read by the /metrics handler)
+inline telemetry_counter_t *telemetry_counters = NULL;
+inline telemetry_hist_t *telemetry_hists = NULL;
+inline telemetry_ring_t *telemetry_rings = NULL;
+
+// ==== Registration ====
+
+/**
+ * Reset and register a counter or gauge
+ * @param counter - Counter to register
+ * @param name - Metric name (static string)
+ * @param gauge - true for a gauge (telemetrySet), false for a counter (telemetryCount)
+ */
+inline void telemetryAddCounter(telemetry_counter_t *counter, const char *name, bool gauge = false) {
+  counter->name = name;
+  counter->gauge = gauge;
+  counter->value.store(0, std::memory_order_relaxed);
+  counter->next = telemetry_counters;
+  telemetry_counters = counter;
+}
+
+/**
+ * Reset and register a histogram
+ * @param hist - Histogram to register
+ * @param name - Metric name (static string)
+ */
+inline void telemetryAddHistogram(telemetry_hist_t *hist, const char *name) {
+  hist->name = name;
+  hist->count.store(0, std::memory_order_relaxed);
+  hist->sum_low.store(0, std::memory_order_relaxed);
+  hist->sum_high.store(0, std::memory_order_relaxed);
+  hist->max.store(0, std::memory_order_relaxed);
+  for (int i = 0; i < TELEMETRY_HIST_BUCKETS; i++) {
+    hist->buckets[i].store(0, std::memory_order_relaxed);
+  }
+  hist->next = telemetry_hists;
+  telemetry_hists = hist;
+}
+
+/**
+ * Reset and register a trace ring
+ * @param ring - Ring to register
+ * @param name - Ring name, usually the writing task (static string)
+ */
+inline void telemetryAddRing(telemetry_ring_t *ring, const char *name) {
+  ring->name = name;
+  ring->head.store(0, std::memory_order_relaxed);
+  ring->next = telemetry_rings;
+  telemetry_rings = ring;
+}
+
+// ==== Recording (hot path) ====
+
+/**
+ * Add to a counter (any task)
+ * @param counter - Counter
+ * @param amount - Increment
+ */
+inline void telemetryCount(telemetry_counter_t *counter, uint32_t amount = 1) {
+  counter->value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+/**
+ * Set a gauge (any task)
+ * @param gauge - Gauge
+ * @param value - New value
+ */
+inline void telemetrySet(telemetry_counter_t *gauge, uint32_t value) {
+  gauge->value.store(value, std::memory_order_relaxed);
+}
+
+/**
+ * Histogram bucket of a value: 0 -> 0, 1 -> 1, 2-3 -> 2, 4-7 -> 3, ...
+ * @param value - Observed value
+ * @return Bucket index
+ */
+inline int telemetryBucket(uint32_t value) {
+  int bucket = value ? 32 - __builtin_clz(value) : 0;
+  return bucket < TELEMETRY_HIST_BUCKETS ? bucket : TELEMETRY_HIST_BUCKETS - 1;
+}
+
+/**
+ * Record a value in a histogram (any task)
+ * @param hist - Histogram
+ * @param value - Observed value
+ */
+inline void telemetryObserve(telemetry_hist_t *hist, uint32_t value) {
+  hist->buckets[telemetryBucket(value)].fetch_add(1, std::memory_order_relaxed);
+  hist->count.fetch_add(1, std::memory_order_relaxed);
+  uint32_t low = hist->sum_low.fetch_add(value, std::memory_order_relaxed);
+  if (low + value < low) {
+    hist->sum_high.fetch_add(1, std::memory_order_relaxed);  // Low word wrapped
+  }
+  uint32_t max = hist->max.load(std::memory_order_relaxed);
+  while (value > max && !hist->max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+/**
+ * Append a sample to a trace ring (only from the ring's writing task)
+ * @param ring - Trace ring
+ * @param type - trace_type_t value
+ * @param value - Sample value (saturated to 24 bits)
+ */
+inline void telemetryTrace(telemetry_ring_t *ring, uint8_t type, uint32_t value) {
+  uint32_t head = ring->head.load(std::memory_order_relaxed);
+  trace_entry_t *entry = &ring->entries[head & (TELEMETRY_RING_SIZE - 1)];
+  entry->time_us = halMicros();
+  entry->word = ((uint32_t)type << 24) | (value > 0xFFFFFF ? 0xFFFFFF : value);
+  ring->head.store(head + 1, std::memory_order_release);  // Publish after the entry is complete
+}
+
+// ==== Export (only runs when /metrics is read) ====
+
+/**
+ * Read the sum of a histogram while other tasks keep observing
+ * @param hist - Histogram
+ * @return Sum of the observed values. A value observed at the same time may
+ *         be missing from it, or its carry (off by 2^32 until the next read)
+ */
+inline uint64_t telemetrySum(telemetry_hist_t *hist) {
+  uint32_t high, low;
+  do {
+    high = hist->sum_high.load(std::memory_order_relaxed);
+    low = hist->sum_low.load(std::memory_order_relaxed);
+  } while (high != hist->sum_high.load(std::memory_order_relaxed));
+  return ((uint64_t)high << 32) | low;
+}
+
+/**
+ * Copy the valid samples of a trace ring while its writer keeps running
+ * @param ring - Trace ring
+ * @param out - Buffer of TELEMETRY_RING_SIZE entries, oldest sample first
+ * @param first_seq - Sequence number of out[0]
+ * @return Number of samples copied
+ */
+inline uint32_t snapshotTraceRing(telemetry_ring_t *ring, trace_entry_t *out, uint32_t *first_seq) {
+  uint32_t end = ring->head.load(std::memory_order_acquire);
+  uint32_t start = end > TELEMETRY_RING_SIZE ? end - TELEMETRY_RING_SIZE : 0;
+  for (uint32_t seq = start; seq != end; seq++) {
+    out[seq - start] = ring->entries[seq & (TELEMETRY_RING_SIZE - 1)];
+  }
+
+  // Samples the writer may have overwritten during the copy are dropped:
+  // sample seq is intact only if seq + TELEMETRY_RING_SIZE > head afterwards
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint32_t head_after = ring->head.load(std::memory_order_relaxed);
+  uint32_t valid_start = head_after >= TELEMETRY_RING_SIZE ? head_after - TELEMETRY_RING_SIZE + 1 : 0;
+  uint32_t skip = valid_start > start ? valid_start - start : 0;
+  if (skip >= end - start) {
+    *first_seq = end;
+    return 0;
+  }
+  memmove(out, out + skip, (end - start - skip) * sizeof(trace_entry_t));
+  *first_seq = start + skip;
+  return end - start - skip;
+}
+
+// Output callback: send len bytes, return false to abort
+typedef bool (*metrics_sink_t)(void *ctx, const void *data, size_t len);
+
+// Buffered metrics output (few large writes instead of one per line)
+typedef struct {
+  metrics_sink_t sink;
+  void *ctx;
+  bool ok;                              // false once the sink failed
+  size_t len;                           // Bytes waiting in buf
+  char buf[512];
+} metrics_writer_t;
+
+/**
+ * Send the buffered bytes
+ * @param w - Writer
+ * @return false if the sink failed
+ */
+inline bool metricsFlush(metrics_writer_t *w) {
+  if (w->ok && w->len > 0) {
+    w->ok = w->sink(w->ctx, w->buf, w->len);
+  }
+  w->len = 0;
+  return w->ok;
+}
+
+/**
+ * Append raw bytes
+ * @param w - Writer
+ * @param data - Bytes
+ * @param len - Number of bytes
+ */
+inline void metricsWrite(metrics_writer_t *w, const void *data, size_t len) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  while (len > 0 && w->ok) {
+    if (w->len == sizeof(w->buf)) {
+      metricsFlush(w);
+    }
+    size_t part = sizeof(w->buf) - w->len < len ? sizeof(w->buf) - w->len : len;
+    memcpy(w->buf + w->len, bytes, part);
+    w->len += part;
+    bytes += part;
+    len -= part;
+  }
+}
+
+/**
+ * Append formatted text (lines are short, longer output is cut)
+ * @param w - Writer
+ * @param fmt - printf format
+ */
+inline void metricsPrintf(metrics_writer_t *w, const char *fmt, ...) {
+  char line[128];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  if (len > 0) {
+    metricsWrite(w, line, len < (int)sizeof(line) ? len : sizeof(line) - 1);
+  }
+}
+
+/**
+ * Append a little-endian 32-bit value
+ * @param w - Writer
+ * @param value - Value
+ */
+inline void metricsPutU32(metrics_writer_t *w, uint32_t value) {
+  uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+  metricsWrite(w, bytes, sizeof(bytes));
+}
+
+/**
+ * Append a name as a zero-padded TELEMETRY_NAME_LEN field
+ * @param w - Writer
+ * @param name - Name
+ */
+inline void metricsPutName(metrics_writer_t *w, const char *name) {
+  char field[TELEMETRY_NAME_LEN] = {};
+  strncpy(field, name, TELEMETRY_NAME_LEN - 1);
+  metricsWrite(w, field, sizeof(field));
+}
+
+/**
+ * Render counters and histograms in the Prometheus text format
+ * (each histogram's maximum is a separate <name>_max gauge)
+ * @param sink - Output callback
+ * @param ctx - Callback context
+ * @return false if the sink failed
+ */
+inline bool writeMetricsText(metrics_sink_t sink, void *ctx) {
+  metrics_writer_t w = { sink, ctx, true, 0, {} };
+  metricsPrintf(&w, "# TYPE uptime_ms gauge\nuptime_ms %lu\n", (unsigned long)halMillis());
+
+  for (telemetry_counter_t *c = telemetry_counters; c; c = c->next) {
+    metricsPrintf(&w, "# TYPE %s %s\n%s %lu\n", c->name, c->gauge ? "gauge" : "counter", c->name,
+                  (unsigned long)c->value.load(std::memory_order_relaxed));
+  }
+
+  for (telemetry_hist_t *h = telemetry_hists; h; h = h->next) {
+    // Cumulative buckets, empty leading/trailing buckets left out
+    uint32_t count = h->count.load(std::memory_order_relaxed);
+    uint32_t cumulative = 0;
+    metricsPrintf(&w, "# TYPE %s histogram\n", h->name);
+    for (int i = 0; i < TELEMETRY_HIST_BUCKETS - 1 && cumulative < count; i++) {
+      uint32_t n = h->buckets[i].load(std::memory_order_relaxed);
+      cumulative += n;
+      if (cumulative > 0) {
+        metricsPrintf(&w, "%s_bucket{le=\"%lu\"} %lu\n", h->name, (unsigned long)((1UL << i) - 1),
+                      (unsigned long)cumulative);
+      }
+    }
+    metricsPrintf(&w, "%s_bucket{le=\"+Inf\"} %lu\n%s_sum %llu\n%s_count %lu\n", h->name, (unsigned long)count,
+                  h->name, (unsigned long long)telemetrySum(h), h->name, (unsigned long)count);
+    metricsPrintf(&w, "# TYPE %s_max gauge\n%s_max %lu\n", h->name, h->name,
+                  (unsigned long)h->max.load(std::memory_order_relaxed));
+  }
+  return metricsFlush(&w);
+}
+
+/**
+ * Dump all metrics including the trace rings (little endian, see tools/decode_metrics.js):
+ *   header:  u32 magic, u32 uptime_ms, u32 counters, u32 histograms, u32 rings, u32 buckets
+ *   counter: name, u32 gauge, u32 value
+ *   hist:    name, u32 count, u32 max, u32 sum_low, u32 sum_high, u32 buckets[]
+ *   ring:    name, u32 first_seq, u32 samples, samples x (u32 time_us, u32 type << 24 | value)
+ * @param sink - Output callback
+ * @param ctx - Callback context
+ * @param scratch - Buffer of TELEMETRY_RING_SIZE entries for ring snapshots
+ * @return false if the sink failed
+ */
+inline bool writeMetricsBinary(metrics_sink_t sink, void *ctx, trace_entry_t *scratch) {
+  metrics_writer_t w = { sink, ctx, true, 0, {} };
+  uint32_t counters = 0, hists = 0, rings = 0;
+  for (telemetry_counter_t *c = telemetry_counters; c; c = c->next) counters++;
+  for (telemetry_hist_t *h = telemetry_hists; h; h = h->next) hists++;
+  for (telemetry_ring_t *r = telemetry_rings; r; r = r->next) rings++;
+
+  metricsPutU32(&w, TELEMETRY_MAGIC);
+  metricsPutU32(&w, halMillis());
+  metricsPutU32(&w, counters);
+  metricsPutU32(&w, hists);
+  metricsPutU32(&w, rings);
+  metricsPutU32(&w, TELEMETRY_HIST_BUCKETS);
+
+  for (telemetry_counter_t *c = telemetry_counters; c; c = c->next) {
+    metricsPutName(&w, c->name);
+    metricsPutU32(&w, c->gauge);
+    metricsPutU32(&w, c->value.load(std::memory_order_relaxed));
+  }
+
+  for (telemetry_hist_t *h = telemetry_hists; h; h = h->next) {
+    metricsPutName(&w, h->name);
+    metricsPutU32(&w, h->count.load(std::memory_order_relaxed));
+    metricsPutU32(&w, h->max.load(std::memory_order_relaxed));
+    uint64_t sum = telemetrySum(h);
+    metricsPutU32(&w, (uint32_t)sum);
+    metricsPutU32(&w, (uint32_t)(sum >> 32));
+    for (int i = 0; i < TELEMETRY_HIST_BUCKETS; i++) {
+      metricsPutU32(&w, h->buckets[i].load(std::memory_order_relaxed));
+    }
+  }
+
+  for (telemetry_ring_t *r = telemetry_rings; r; r = r->next) {
+    uint32_t first_seq;
+    uint32_t samples = snapshotTraceRing(r, scratch, &first_seq);
+    metricsPutName(&w, r->name);
+    metricsPutU32(&w, first_seq);
+    metricsPutU32(&w, samples);
+    for (uint32_t i = 0; i < samples; i++) {
+      metricsPutU32(&w, scratch[i].time_us);
+      metricsPutU32(&w, scratch[i].word);
+    }
+  }
+  return metricsFlush(&w);
+}
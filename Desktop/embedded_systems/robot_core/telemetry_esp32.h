@@ -0,0 +1,80 @@
+/**
+ * ESP32 side of the telemetry: /metrics handler and system samples
+ */
+#pragma once
+
+#include <Arduino.h>
+#include "esp_http_server.h"
+#include "telemetry.h"
+
+#define SYSTEM_SAMPLE_MS  1000   // Free heap / PSRAM sampling interval
+
+// System metrics, sampled by the Arduino loop task
+typedef struct {
+  telemetry_ring_t trace;               // Free heap / PSRAM history
+  telemetry_counter_t free_heap;        // Free internal heap in bytes
+  telemetry_counter_t min_free_heap;    // Lowest free heap since boot
+  telemetry_counter_t free_psram;       // Free PSRAM in bytes (0 without PSRAM)
+} system_telemetry_t;
+
+/**
+ * Register the system metrics
+ * @param sys - System metrics
+ */
+inline void systemTelemetryInit(system_telemetry_t *sys) {
+  telemetryAddRing(&sys->trace, "system");
+  telemetryAddCounter(&sys->free_heap, "free_heap", true);
+  telemetryAddCounter(&sys->min_free_heap, "min_free_heap", true);
+  telemetryAddCounter(&sys->free_psram, "free_psram", true);
+}
+
+/**
+ * Sample free heap and PSRAM (call every SYSTEM_SAMPLE_MS from one task)
+ * @param sys - System metrics
+ */
+inline void recordSystemTelemetry(system_telemetry_t *sys) {
+  uint32_t heap = ESP.getFreeHeap();
+  uint32_t psram = ESP.getFreePsram();
+  telemetrySet(&sys->free_heap, heap);
+  telemetrySet(&sys->min_free_heap, ESP.getMinFreeHeap());
+  telemetrySet(&sys->free_psram, psram);
+  telemetryTrace(&sys->trace, TRACE_FREE_HEAP, heap);
+  telemetryTrace(&sys->trace, TRACE_FREE_PSRAM, psram);
+}
+
+/**
+ * Metrics sink writing HTTP chunks
+ * @param ctx - HTTP request
+ * @param data - Bytes to send
+ * @param len - Number of bytes
+ * @return false if the client went away
+ */
+inline bool httpMetricsSink(void *ctx, const void *data, size_t len) {
+  return httpd_resp_send_chunk((httpd_req_t *)ctx, (const char *)data, len) == ESP_OK;
+}
+
+/**
+ * HTTP request handler for /metrics
+ * Text (Prometheus format) by default, /metrics?format=bin for the full dump
+ * including trace rings (decode with tools/decode_metrics.js)
+ */
+static esp_err_t metrics_handler(httpd_req_t *req) {
+  // The server runs handlers one at a time, so one snapshot buffer is enough
+  static trace_entry_t scratch[TELEMETRY_RING_SIZE];
+
+  char query[32];
+  char format[8];
+  bool binary = httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+                httpd_query_key_value(query, "format", format, sizeof(format)) == ESP_OK &&
+                strcmp(format, "bin") == 0;
+
+  httpd_resp_set_type(req, binary ? "application/octet-stream" : "text/plain; version=0.0.4");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+
+  bool ok = binary ? writeMetricsBinary(httpMetricsSink, req, scratch) : writeMetricsText(httpMetricsSink, req);
+  if (!ok) {
+    return ESP_FAIL;                    // Client went away
+  }
+  return httpd_resp_send_chunk(req, NULL, 0);  // End of response
+}
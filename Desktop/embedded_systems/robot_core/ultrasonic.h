@@ -0,0 +1,155 @@
+/**
+ * Non-blocking HC-SR04 ranging with a median filter
+ *
+ * The echo pulse is timestamped by a pin interrupt (both edges) that calls
+ * ultrasonicEchoEdge(); the control task calls ultrasonicPoll() once per
+ * period to collect the finished echo and trigger the next ping, so nothing
+ * busy-waits in pulseIn(). A median over the last readings keeps single
+ * noisy echoes from triggering the emergency reverse.
+ *
+ * The next ping is sent as soon as the previous echo has ended (or timed out)
+ * and ECHO has been low for PING_RECOVERY_US, not on a fixed 60 ms cycle, so
+ * a near obstacle is ranged once per control period. After a lost ping the
+ * module can hold ECHO high past ECHO_TIMEOUT_US and ignores triggers until
+ * it drops. Echoes that started before the current ping belong to an earlier
+ * one and are discarded, so a lost ping is counted once; a late reflection of
+ * an earlier ping taken for this one is a single reading the median rejects.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "robot_hal.h"
+
+// ==== Ranging Settings ====
+#define ECHO_TIMEOUT_US        30000   // Ping is considered lost after 30ms (~5m range)
+#define PING_RECOVERY_US       1000    // ECHO low this long before the next trigger
+#define ECHO_STUCK_US          250000  // ECHO high this long after a trigger = module hung, trigger anyway
+#define MAX_DISTANCE_CM        400     // HC-SR04 maximum range, also used for "no echo"
+#define DISTANCE_FILTER_SIZE   3       // Number of samples in the median filter (odd)
+
+// Sensor state
+typedef struct {
+  int trig_pin;                         // Trigger output
+
+  // Echo capture (written by the interrupt, read by the control task)
+  volatile uint32_t echo_rise_us;       // Timestamp of the echo rising edge
+  volatile uint32_t echo_width_us;      // Width of the last complete echo pulse
+  volatile uint32_t echo_end_us;        // Timestamp of the last echo falling edge
+  volatile bool echo_ready;             // Set when a new echo width is available
+  volatile bool echo_high;              // ECHO level after the last edge
+
+  // Ping and filter state (owned by the control task)
+  bool ping_active;                     // True while waiting for an echo
+  uint32_t ping_start_us;               // Time the current ping was triggered
+  uint32_t sample_us;                   // Time the latest reading was measured
+  long samples[DISTANCE_FILTER_SIZE];   // Last readings in centimeters
+  int index;                            // Next slot to overwrite
+  long distance_cm;                     // Latest filtered distance in centimeters
+} ultrasonic_t;
+
+/**
+ * Reset the sensor state (nothing in range) and configure the trigger pin
+ * @param sensor - Sensor state
+ * @param trig_pin - Trigger output pin
+ */
+inline void ultrasonicInit(ultrasonic_t *sensor, int trig_pin) {
+  sensor->trig_pin = trig_pin;
+  sensor->echo_rise_us = 0;
+  sensor->echo_width_us = 0;
+  sensor->echo_end_us = 0;
+  sensor->echo_ready = false;
+  sensor->echo_high = false;
+  sensor->ping_active = false;
+  sensor->ping_start_us = 0;
+  sensor->sample_us = 0;
+  for (int i = 0; i < DISTANCE_FILTER_SIZE; i++) {
+    sensor->samples[i] = MAX_DISTANCE_CM;
+  }
+  sensor->index = 0;
+  sensor->distance_cm = MAX_DISTANCE_CM;
+  halGpioOutput(trig_pin);
+}
+
+/**
+ * Record one edge of the echo pulse (call from the echo pin interrupt)
+ * @param sensor - Sensor state
+ * @param level - Echo pin level after the edge
+ * @param now_us - Edge timestamp in microseconds
+ */
+ROBOT_ISR_INLINE void ultrasonicEchoEdge(ultrasonic_t *sensor, bool level, uint32_t now_us) {
+  if (level) {
+    sensor->echo_rise_us = now_us;                        // Echo started
+  } else {
+    sensor->echo_width_us = now_us - sensor->echo_rise_us;  // Echo ended - store pulse width
+    sensor->echo_end_us = now_us;
+    sensor->echo_ready = true;
+  }
+  sensor->echo_high = level;            // Last: a low level comes with its echo_end_us
+}
+
+/**
+ * Median filter over the last DISTANCE_FILTER_SIZE readings
+ * @param sensor - Sensor state
+ * @param sample - Newest distance reading in centimeters
+ * @return Median of the stored readings in centimeters
+ */
+inline long ultrasonicMedian(ultrasonic_t *sensor, long sample) {
+  // Out-of-range readings (no echo, too far) count as "nothing in range"
+  if (sample <= 0 || sample > MAX_DISTANCE_CM) {
+    sample = MAX_DISTANCE_CM;
+  }
+  sensor->samples[sensor->index] = sample;
+  sensor->index = (sensor->index + 1) % DISTANCE_FILTER_SIZE;
+
+  // Insertion sort a copy of the history (small N, no heap use)
+  long sorted[DISTANCE_FILTER_SIZE];
+  for (int i = 0; i < DISTANCE_FILTER_SIZE; i++) {
+    long value = sensor->samples[i];
+    int j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  return sorted[DISTANCE_FILTER_SIZE / 2];
+}
+
+/**
+ * Service the sensor without blocking
+ * Collects a finished echo (or a lost ping) and triggers the next ping when
+ * the measurement cycle allows it
+ * @param sensor - Sensor state
+ */
+inline void ultrasonicPoll(ultrasonic_t *sensor) {
+  uint32_t now = halMicros();
+  if (sensor->echo_ready) {
+    sensor->echo_ready = false;
+    // Only an echo that rose after the trigger answers this ping; the late end
+    // of a ping already counted as lost is dropped
+    if (sensor->ping_active && (int32_t)(sensor->echo_rise_us - sensor->ping_start_us) >= 0) {
+      sensor->ping_active = false;
+      sensor->sample_us = sensor->echo_end_us;
+      // Speed of sound = 343 m/s = 0.0343 cm/µs
+      // Distance = (time × speed) / 2 (divided by 2 for round trip)
+      sensor->distance_cm = ultrasonicMedian(sensor, sensor->echo_width_us * 0.034 / 2);
+    }
+  }
+  if (sensor->ping_active && now - sensor->ping_start_us > ECHO_TIMEOUT_US) {
+    sensor->ping_active = false;
+    sensor->sample_us = now;
+    sensor->distance_cm = ultrasonicMedian(sensor, MAX_DISTANCE_CM);  // No echo - nothing in range
+  }
+
+  // Re-arm once the echo is over; the module ignores a trigger while ECHO is
+  // still high from the last ping
+  bool echo_over = !sensor->echo_high && now - sensor->echo_end_us >= PING_RECOVERY_US;
+  if (!sensor->ping_active && (echo_over || now - sensor->ping_start_us >= ECHO_STUCK_US)) {
+    // Send 10µs trigger pulse, the echo is measured by the interrupt
+    halGpioWrite(sensor->trig_pin, true);
+    halDelayMicros(10);
+    halGpioWrite(sensor->trig_pin, false);
+    sensor->ping_start_us = halMicros();
+    sensor->ping_active = true;
+  }
+}
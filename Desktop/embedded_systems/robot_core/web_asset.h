@@ -0,0 +1,58 @@
+/**
+ * Precompressed web asset served from flash
+ *
+ * The pages are minified and gzipped at build time (tools/build_web_assets.js
+ * -> web_assets.h), so the robot sends a few hundred bytes per page load and
+ * a browser revalidating with If-None-Match gets a bodiless 304.
+ *
+ * Plain C++ without Arduino dependencies, so it also builds on a PC.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// One gzip-encoded asset
+typedef struct {
+  const uint8_t *data;                  // gzip bytes
+  size_t len;                           // Number of gzip bytes
+  const char *content_type;             // MIME type of the uncompressed content
+  const char *etag;                     // Strong ETag including the quotes
+} web_asset_t;
+
+/**
+ * Check an If-None-Match header against the asset's ETag
+ * Accepts "*", a list of tags and weak tags (W/"..."), as the header allows
+ * @param if_none_match - Header value
+ * @param etag - ETag of the asset including the quotes
+ * @return true if the browser's cached copy is current (answer 304)
+ */
+inline bool etagMatches(const char *if_none_match, const char *etag) {
+  size_t etag_len = strlen(etag);
+  const char *p = if_none_match;
+  while (*p) {
+    while (*p == ' ' || *p == ',') {
+      p++;
+    }
+    if (*p == '*') {
+      return true;
+    }
+    if (strncmp(p, "W/", 2) == 0) {
+      p += 2;                           // If-None-Match uses weak comparison
+    }
+    const char *end = p;
+    while (*end && *end != ',') {
+      end++;
+    }
+    const char *tag_end = end;
+    while (tag_end > p && tag_end[-1] == ' ') {
+      tag_end--;
+    }
+    if ((size_t)(tag_end - p) == etag_len && strncmp(p, etag, etag_len) == 0) {
+      return true;
+    }
+    p = end;
+  }
+  return false;
+}
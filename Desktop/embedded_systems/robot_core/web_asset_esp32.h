@@ -0,0 +1,32 @@
+/**
+ * Serve a precompressed web asset with esp_http_server
+ */
+#pragma once
+
+#include "esp_http_server.h"
+#include "web_asset.h"
+
+/**
+ * Send a gzip asset, or 304 Not Modified if the browser already has it
+ * Every browser accepts gzip, so there is no uncompressed fallback
+ * @param req - HTTP request
+ * @param asset - Asset to send
+ * @return ESP_OK on success, error code otherwise
+ */
+inline esp_err_t sendWebAsset(httpd_req_t *req, const web_asset_t *asset) {
+  // Revalidation each visit (no-cache) is one small request, and a new
+  // firmware with changed pages is picked up immediately
+  httpd_resp_set_hdr(req, "ETag", asset->etag);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+  char if_none_match[64];
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match, sizeof(if_none_match)) == ESP_OK &&
+      etagMatches(if_none_match, asset->etag)) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    return httpd_resp_send(req, NULL, 0);
+  }
+
+  httpd_resp_set_type(req, asset->content_type);
+  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  return httpd_resp_send(req, (const char *)asset->data, asset->len);
+}
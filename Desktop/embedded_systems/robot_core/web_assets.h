@@ -0,0 +1,206 @@
+/**
+ * Precompressed web pages (generated by tools/build_web_assets.js from web/)
+ * Do not edit by hand - change web/ and re-run the script.
+ */
+#pragma once
+
+#include "web_asset.h"
+
+// Control page of the ESP32 robot without camera (1902 bytes, 889 gzipped)
+constexpr uint8_t web_index_robot_gz[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x55, 0xdb, 0x6e, 0xe3, 0x36,
+  0x10, 0xfd, 0x15, 0x56, 0x41, 0x20, 0x1b, 0x1b, 0xdd, 0xec, 0x38, 0x4d, 0xa9, 0x0b, 0x90, 0xf5,
+  0x3a, 0xed, 0xa2, 0x05, 0x12, 0x38, 0x2e, 0x8a, 0x3e, 0xd2, 0xe4, 0xd8, 0x62, 0x43, 0x91, 0x02,
+  0x49, 0xdb, 0x72, 0x0d, 0xff, 0x7b, 0x41, 0xc9, 0x89, 0xe5, 0x0d, 0xf6, 0xa1, 0x40, 0x0b, 0x01,
+  0xba, 0x0c, 0x87, 0x73, 0x66, 0xce, 0x9c, 0x11, 0xb3, 0x1f, 0xbe, 0x3c, 0x4d, 0x17, 0x7f, 0x3e,
+  0xcf, 0x50, 0x69, 0x2b, 0x51, 0x64, 0xee, 0x8e, 0x04, 0x91, 0xeb, 0xdc, 0x03, 0xe9, 0x15, 0x59,
+  0x09, 0x84, 0x15, 0x59, 0x05, 0x96, 0x20, 0x5a, 0x12, 0x6d, 0xc0, 0xe6, 0xde, 0xef, 0x8b, 0xc7,
+  0xe0, 0xde, 0x3b, 0x59, 0x25, 0xa9, 0x20, 0xf7, 0xb6, 0x1c, 0x76, 0xb5, 0xd2, 0xd6, 0x43, 0x54,
+  0x49, 0x0b, 0xd2, 0xe6, 0xde, 0x8e, 0x33, 0x5b, 0xe6, 0x0c, 0xb6, 0x9c, 0x42, 0xd0, 0x7e, 0xdc,
+  0x20, 0x2e, 0xb9, 0xe5, 0x44, 0x04, 0x86, 0x12, 0x01, 0x79, 0x12, 0xc6, 0x5e, 0x91, 0x59, 0x6e,
+  0x05, 0x14, 0xb3, 0x97, 0xe7, 0xf1, 0x08, 0xcd, 0xd5, 0x52, 0x59, 0x34, 0x55, 0xd2, 0x6a, 0x25,
+  0xb2, 0xa8, 0x5b, 0xca, 0x8c, 0xdd, 0x0b, 0x28, 0x96, 0x8a, 0xed, 0x0f, 0x2b, 0x25, 0x6d, 0xb0,
+  0x22, 0x15, 0x17, 0x7b, 0xfc, 0xa0, 0x39, 0x11, 0x37, 0x86, 0x48, 0x13, 0x18, 0xd0, 0x7c, 0x95,
+  0x5a, 0x68, 0x6c, 0x40, 0x04, 0x5f, 0x4b, 0x4c, 0x41, 0x5a, 0xd0, 0x69, 0x45, 0xf4, 0x9a, 0x4b,
+  0x9c, 0xc4, 0x75, 0x93, 0xd6, 0x84, 0x31, 0x2e, 0xd7, 0x38, 0x4e, 0x97, 0x84, 0xbe, 0xae, 0xb5,
+  0xda, 0x48, 0x86, 0xaf, 0x56, 0xb1, 0xbb, 0x8e, 0xa1, 0x4b, 0x9b, 0x70, 0x09, 0xfa, 0x50, 0x91,
+  0xa6, 0x4b, 0x17, 0xdf, 0xc5, 0x6e, 0xdf, 0x29, 0x46, 0x8c, 0xc8, 0xc6, 0xaa, 0xfe, 0xde, 0x5d,
+  0xc9, 0x2d, 0xbc, 0x87, 0x4d, 0x26, 0x75, 0x93, 0x2e, 0x95, 0x66, 0xa0, 0x03, 0x4d, 0x18, 0xdf,
+  0x98, 0x0e, 0x76, 0xa9, 0x9a, 0xc0, 0x94, 0x84, 0xa9, 0x1d, 0x8e, 0xd1, 0xa8, 0x6e, 0x90, 0xb3,
+  0x22, 0xbd, 0x5e, 0x92, 0x41, 0x7c, 0xd3, 0x5e, 0x61, 0x32, 0x3c, 0x96, 0xc9, 0x81, 0x2a, 0xa1,
+  0x34, 0xbe, 0x1a, 0x8f, 0xc7, 0x27, 0xc8, 0xc0, 0xaa, 0x1a, 0xc7, 0xc7, 0xd0, 0x58, 0x0d, 0xa4,
+  0x0a, 0xce, 0x19, 0xd6, 0xca, 0x70, 0xcb, 0x95, 0xc4, 0x1a, 0x04, 0xb1, 0x7c, 0x0b, 0xfd, 0x3a,
+  0x51, 0x9c, 0xaa, 0x2d, 0xe8, 0x95, 0x50, 0x3b, 0x5c, 0x72, 0xc6, 0x40, 0x7e, 0x93, 0xd5, 0x39,
+  0x4f, 0x9c, 0xd4, 0x0d, 0x32, 0x4a, 0x70, 0x86, 0xae, 0x28, 0xa5, 0x6f, 0x48, 0x07, 0xc6, 0x4d,
+  0x2d, 0xc8, 0x1e, 0x2f, 0x85, 0xa2, 0xaf, 0x69, 0xc7, 0x45, 0x12, 0xc7, 0xd7, 0x69, 0x09, 0x7c,
+  0x5d, 0x5a, 0xdc, 0x12, 0x71, 0x41, 0xcb, 0x31, 0x5c, 0x6e, 0xac, 0x55, 0xf2, 0xd0, 0xa7, 0xf6,
+  0x76, 0xfa, 0xf0, 0x38, 0x89, 0xd3, 0xae, 0xae, 0x8e, 0xac, 0x13, 0xae, 0x54, 0xb2, 0x47, 0xdc,
+  0xa8, 0x6e, 0x4e, 0x20, 0xf7, 0xf1, 0x75, 0x7a, 0xa6, 0x7f, 0xd4, 0xa7, 0x7f, 0x52, 0x37, 0x5d,
+  0x03, 0x2e, 0x93, 0x6b, 0xf5, 0x60, 0xf8, 0xdf, 0x80, 0x93, 0xfb, 0x0f, 0xfc, 0xbb, 0x4a, 0xe9,
+  0x46, 0x1b, 0xa5, 0x71, 0xad, 0x78, 0x2b, 0x08, 0xab, 0x89, 0x3c, 0x91, 0x77, 0x4e, 0x15, 0xc5,
+  0xe1, 0xd8, 0xbc, 0x95, 0x80, 0x4b, 0x47, 0xdf, 0x65, 0x21, 0x13, 0x12, 0xdf, 0xfe, 0xf4, 0xee,
+  0x40, 0xa8, 0xe3, 0xfc, 0xc2, 0x63, 0x3c, 0xf9, 0x91, 0x8c, 0xef, 0x3b, 0x15, 0x69, 0x25, 0xcc,
+  0xe1, 0xa2, 0x21, 0xc7, 0x50, 0xab, 0xdd, 0x3b, 0xab, 0x2b, 0x01, 0x4d, 0xfa, 0xd7, 0xc6, 0x58,
+  0xbe, 0xda, 0x07, 0xa7, 0x69, 0xc1, 0xa6, 0x26, 0x14, 0x82, 0x25, 0xd8, 0x1d, 0x80, 0xec, 0x71,
+  0x30, 0xfe, 0x28, 0x41, 0x87, 0x22, 0x0e, 0xa7, 0xe5, 0xd1, 0xb5, 0xeb, 0x1a, 0xb1, 0x1b, 0x73,
+  0xe8, 0x51, 0x71, 0xeb, 0x0a, 0xef, 0xe4, 0x74, 0x77, 0x77, 0xd7, 0x97, 0x93, 0x53, 0xe9, 0x31,
+  0x8b, 0xba, 0x89, 0xca, 0xa2, 0x6e, 0xba, 0xdd, 0x64, 0x15, 0x19, 0xe3, 0x5b, 0x44, 0x05, 0x31,
+  0x26, 0xf7, 0xde, 0xa5, 0xe6, 0x7e, 0x00, 0x49, 0x7f, 0x36, 0xb3, 0xa8, 0x4c, 0x3e, 0xb8, 0xba,
+  0x8a, 0xbd, 0x22, 0xeb, 0xe8, 0x79, 0x5b, 0xe8, 0xbe, 0x3c, 0xa4, 0x24, 0x15, 0x9c, 0xbe, 0xe6,
+  0x9e, 0x01, 0xc9, 0xa6, 0xaa, 0xaa, 0x88, 0x64, 0x03, 0x7f, 0xad, 0xfc, 0xa1, 0x57, 0x3c, 0x3e,
+  0xcd, 0xff, 0x78, 0x98, 0x7f, 0xc9, 0xa2, 0xce, 0xf9, 0x22, 0xb0, 0x56, 0x3b, 0xef, 0x1b, 0x24,
+  0xf1, 0x5d, 0x90, 0xb6, 0x9e, 0xd3, 0x2f, 0xa7, 0x95, 0xea, 0xf7, 0x70, 0x05, 0xac, 0xac, 0x43,
+  0xfe, 0x6d, 0xf6, 0xb8, 0x38, 0xc3, 0x46, 0x8c, 0x6f, 0xff, 0x7b, 0x2c, 0x63, 0x55, 0xed, 0xb0,
+  0x5e, 0x16, 0x4f, 0xcf, 0xff, 0x37, 0x96, 0x76, 0x83, 0xe9, 0xc0, 0xe6, 0x5f, 0x7f, 0xfe, 0xe5,
+  0x43, 0x65, 0xdd, 0xfd, 0xdf, 0xf4, 0xc7, 0x89, 0xdb, 0x85, 0xfb, 0xfc, 0x30, 0xfd, 0xf5, 0xb2,
+  0x45, 0xf5, 0x5b, 0x80, 0x4e, 0x76, 0x5e, 0xf1, 0xd2, 0x3e, 0x31, 0xca, 0x4c, 0x4d, 0x24, 0xe2,
+  0xec, 0xbc, 0x32, 0x07, 0xc2, 0xf6, 0x59, 0xe4, 0xec, 0x45, 0x16, 0xd5, 0x97, 0xd9, 0x18, 0xaa,
+  0x79, 0x6d, 0x8b, 0xd5, 0x46, 0x52, 0x37, 0x8e, 0xa8, 0x0f, 0x4f, 0x2b, 0x36, 0x44, 0x07, 0xa6,
+  0xe8, 0xa6, 0x02, 0x69, 0xc3, 0x35, 0xd8, 0x99, 0x00, 0xf7, 0xfa, 0x79, 0xff, 0xb5, 0x25, 0xd6,
+  0xc5, 0xf7, 0x87, 0x21, 0x97, 0x12, 0xf4, 0x02, 0x1a, 0x8b, 0x72, 0x44, 0x2b, 0x86, 0x3e, 0x21,
+  0x1f, 0xd1, 0x2e, 0x86, 0x8b, 0x67, 0xfd, 0x74, 0x05, 0x96, 0x96, 0x03, 0x3f, 0xf2, 0xd1, 0x27,
+  0xe7, 0x31, 0x0c, 0x6d, 0x09, 0x72, 0xa0, 0xc1, 0xd4, 0x4a, 0x1a, 0x40, 0x79, 0xe1, 0xce, 0x2b,
+  0xa3, 0x04, 0x84, 0x42, 0xad, 0x07, 0xfe, 0xb4, 0xb7, 0x19, 0xa3, 0xb7, 0x4d, 0xc3, 0x90, 0x12,
+  0x17, 0x06, 0xb4, 0x56, 0xba, 0xbf, 0xa7, 0x35, 0x0c, 0xfc, 0x99, 0x7b, 0x60, 0xe4, 0xdf, 0xa0,
+  0xd6, 0x30, 0x1c, 0xa6, 0x6e, 0xc4, 0xba, 0xfa, 0xb2, 0xa8, 0x9b, 0xae, 0xa8, 0x3d, 0x5e, 0xff,
+  0x01, 0xf9, 0xe3, 0xcc, 0x9f, 0x6e, 0x07, 0x00, 0x00,
+};
+constexpr web_asset_t web_index_robot = {
+  web_index_robot_gz, sizeof(web_index_robot_gz), "text/html; charset=utf-8", "\"2ba2e5dc1342a10b\""
+};
+
+// Control page of the ESP32-CAM robot with the live stream (2182 bytes, 992 gzipped)
+constexpr uint8_t web_index_camera_gz[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x56, 0xdb, 0x6e, 0xe3, 0x36,
+  0x10, 0xfd, 0x15, 0x56, 0x41, 0x60, 0x1b, 0x1b, 0xdd, 0xec, 0x24, 0x75, 0x74, 0x03, 0xb2, 0xde,
+  0xa4, 0x5d, 0xb4, 0x45, 0x82, 0x24, 0x45, 0xd1, 0x47, 0x9a, 0x1c, 0x59, 0xdc, 0x50, 0xa4, 0x40,
+  0xd2, 0xb6, 0x5c, 0xc3, 0xff, 0x5e, 0x50, 0x52, 0x62, 0xc9, 0xe9, 0x3e, 0x14, 0x68, 0x21, 0x40,
+  0x36, 0x87, 0xe4, 0x9c, 0x39, 0x87, 0x67, 0x68, 0x27, 0x3f, 0x7c, 0x79, 0x58, 0xbc, 0xfc, 0xf9,
+  0x78, 0x87, 0x0a, 0x53, 0xf2, 0x2c, 0xb1, 0x6f, 0xc4, 0xb1, 0x58, 0xa5, 0x0e, 0x08, 0x27, 0x4b,
+  0x0a, 0xc0, 0x34, 0x4b, 0x4a, 0x30, 0x18, 0x91, 0x02, 0x2b, 0x0d, 0x26, 0x75, 0x7e, 0x7f, 0xb9,
+  0x77, 0xe7, 0x4e, 0x17, 0x15, 0xb8, 0x84, 0xd4, 0xd9, 0x30, 0xd8, 0x56, 0x52, 0x19, 0x07, 0x11,
+  0x29, 0x0c, 0x08, 0x93, 0x3a, 0x5b, 0x46, 0x4d, 0x91, 0x52, 0xd8, 0x30, 0x02, 0x6e, 0x33, 0xb8,
+  0x40, 0x4c, 0x30, 0xc3, 0x30, 0x77, 0x35, 0xc1, 0x1c, 0xd2, 0xd0, 0x0b, 0x9c, 0x2c, 0x31, 0xcc,
+  0x70, 0xc8, 0xee, 0x9e, 0x1f, 0x67, 0x53, 0x77, 0x71, 0xfb, 0x1b, 0x7a, 0x92, 0x4b, 0x69, 0xd0,
+  0x42, 0x0a, 0xa3, 0x24, 0x4f, 0xfc, 0x76, 0x3a, 0xd1, 0x66, 0xc7, 0x21, 0x5b, 0x4a, 0xba, 0xdb,
+  0xe7, 0x52, 0x18, 0x37, 0xc7, 0x25, 0xe3, 0xbb, 0xe8, 0x56, 0x31, 0xcc, 0x2f, 0x34, 0x16, 0xda,
+  0xd5, 0xa0, 0x58, 0x1e, 0x1b, 0xa8, 0x8d, 0x8b, 0x39, 0x5b, 0x89, 0x88, 0x80, 0x30, 0xa0, 0xe2,
+  0x12, 0xab, 0x15, 0x13, 0x51, 0x18, 0x54, 0x75, 0x5c, 0x61, 0x4a, 0x99, 0x58, 0x45, 0x41, 0xbc,
+  0xc4, 0xe4, 0x75, 0xa5, 0xe4, 0x5a, 0xd0, 0xe8, 0x2c, 0x0f, 0xec, 0x73, 0xf0, 0x6c, 0xe9, 0x98,
+  0x09, 0x50, 0xfb, 0x12, 0xd7, 0x6d, 0xc9, 0xd1, 0x75, 0x60, 0xf7, 0x75, 0x39, 0x02, 0x84, 0xd7,
+  0x46, 0xf6, 0xf7, 0x6e, 0x0b, 0x66, 0xe0, 0x3d, 0x6d, 0x78, 0x55, 0xd5, 0xf1, 0x52, 0x2a, 0x0a,
+  0xca, 0x55, 0x98, 0xb2, 0xb5, 0x6e, 0x61, 0x97, 0xb2, 0x76, 0x75, 0x81, 0xa9, 0xdc, 0x46, 0x01,
+  0x9a, 0x56, 0x35, 0xb2, 0x51, 0xa4, 0x56, 0x4b, 0x3c, 0x0e, 0x2e, 0x9a, 0xc7, 0x0b, 0x27, 0x87,
+  0x22, 0xdc, 0x13, 0xc9, 0xa5, 0x8a, 0xce, 0x66, 0xb3, 0x59, 0x07, 0xe9, 0x1a, 0x59, 0x45, 0xc1,
+  0xc1, 0xd3, 0x46, 0x01, 0x2e, 0xdd, 0x63, 0x85, 0x95, 0xd4, 0xcc, 0x30, 0x29, 0x22, 0x05, 0x1c,
+  0x1b, 0xb6, 0x81, 0x3e, 0x4f, 0x14, 0xc4, 0x72, 0x03, 0x2a, 0xe7, 0x72, 0x1b, 0x15, 0x8c, 0x52,
+  0x10, 0x27, 0x55, 0x1d, 0xeb, 0x8c, 0xc2, 0xaa, 0x46, 0x5a, 0x72, 0x46, 0xd1, 0x19, 0x21, 0xe4,
+  0x0d, 0x69, 0x4f, 0x99, 0xae, 0x38, 0xde, 0x45, 0x4b, 0x2e, 0xc9, 0x6b, 0xdc, 0x6a, 0x11, 0x06,
+  0xc1, 0x79, 0x5c, 0x00, 0x5b, 0x15, 0x26, 0x6a, 0x84, 0x18, 0xc8, 0x72, 0xf0, 0x96, 0x6b, 0x63,
+  0xa4, 0xd8, 0xf7, 0xa5, 0xbd, 0x5c, 0xdc, 0xde, 0x5f, 0x05, 0x71, 0xcb, 0xab, 0x15, 0xab, 0xc3,
+  0x15, 0x52, 0xf4, 0x84, 0x9b, 0x56, 0x75, 0x07, 0x32, 0x0f, 0xce, 0xe3, 0xa3, 0xfc, 0xd3, 0xbe,
+  0xfc, 0x57, 0x55, 0xdd, 0x1e, 0xc0, 0xb0, 0xb8, 0xc6, 0x0f, 0x9a, 0xfd, 0x05, 0x51, 0x38, 0xff,
+  0xa0, 0xbf, 0x65, 0x4a, 0xd6, 0x4a, 0x4b, 0x15, 0x55, 0x92, 0x35, 0x86, 0x30, 0x0a, 0x8b, 0x4e,
+  0xbc, 0x63, 0xa9, 0x28, 0xf0, 0x66, 0xfa, 0x8d, 0x42, 0x54, 0x58, 0xf9, 0x86, 0x44, 0xae, 0x70,
+  0x70, 0x79, 0xf3, 0xbe, 0x00, 0x13, 0xab, 0xf9, 0x60, 0xc5, 0xec, 0xea, 0x47, 0x3c, 0x9b, 0xb7,
+  0x2e, 0x52, 0x92, 0xeb, 0xfd, 0xe0, 0x40, 0x0e, 0x9e, 0x92, 0xdb, 0x77, 0x55, 0x73, 0x0e, 0x75,
+  0xfc, 0x6d, 0xad, 0x0d, 0xcb, 0x77, 0x6e, 0xd7, 0x31, 0x91, 0xae, 0x30, 0x01, 0x77, 0x09, 0x66,
+  0x0b, 0x20, 0x7a, 0x1a, 0xcc, 0x3e, 0x5a, 0xd0, 0xa2, 0xf0, 0x7d, 0x37, 0x3d, 0x3d, 0xb7, 0xa7,
+  0x86, 0xcd, 0x5a, 0xef, 0x7b, 0x52, 0x5c, 0x5a, 0xe2, 0xad, 0x9d, 0xae, 0xaf, 0xaf, 0xfb, 0x76,
+  0xb2, 0x2e, 0x3d, 0x24, 0x7e, 0xdb, 0x51, 0x89, 0xdf, 0x76, 0xb8, 0xed, 0xac, 0x2c, 0xa1, 0x6c,
+  0x83, 0x08, 0xc7, 0x5a, 0xa7, 0xce, 0xbb, 0xd5, 0xec, 0x25, 0x10, 0x9e, 0xf6, 0x67, 0xe2, 0x17,
+  0xe1, 0x60, 0xf9, 0xa9, 0x41, 0x1d, 0xd4, 0xe4, 0xef, 0xae, 0x81, 0x28, 0x9c, 0x5b, 0x0e, 0x9d,
+  0x77, 0xc2, 0x4b, 0x3b, 0x18, 0x68, 0xd1, 0x74, 0xac, 0xcb, 0x0c, 0x94, 0xfa, 0xad, 0x6f, 0x4f,
+  0xe5, 0xe9, 0xc2, 0x4e, 0x96, 0xb0, 0x72, 0x85, 0xb4, 0x22, 0xa9, 0xe3, 0xb7, 0xa8, 0xce, 0xb0,
+  0x08, 0x07, 0x61, 0x6e, 0x52, 0x67, 0x81, 0x4b, 0x50, 0x18, 0xe5, 0x00, 0xf4, 0xb4, 0x98, 0xeb,
+  0x7e, 0x31, 0x53, 0x3b, 0x90, 0xcb, 0x6f, 0x40, 0x8c, 0x9b, 0x33, 0x13, 0x75, 0x14, 0x86, 0x4d,
+  0x1b, 0xa0, 0x79, 0x55, 0xa3, 0xb3, 0x9b, 0x9b, 0x9b, 0x13, 0x7f, 0x59, 0x99, 0x9d, 0x2c, 0xf1,
+  0x29, 0xdb, 0x7c, 0x90, 0xcf, 0xba, 0xc0, 0xc9, 0x92, 0xd6, 0x32, 0x6f, 0x13, 0xed, 0xc8, 0x41,
+  0x52, 0x10, 0xce, 0xc8, 0x6b, 0xea, 0x68, 0x10, 0x74, 0x21, 0xcb, 0x12, 0x0b, 0x3a, 0x1e, 0xad,
+  0xe4, 0x68, 0xe2, 0x64, 0xf7, 0x0f, 0x4f, 0x7f, 0xdc, 0x3e, 0x7d, 0x49, 0xfc, 0x76, 0xf1, 0x20,
+  0xb1, 0x92, 0x5b, 0xe7, 0x04, 0x89, 0x7f, 0x17, 0x64, 0x48, 0x3b, 0x08, 0xce, 0xbf, 0x87, 0xcb,
+  0x21, 0x37, 0x16, 0xf9, 0xd7, 0xbb, 0xfb, 0x97, 0x23, 0xec, 0x3f, 0xb0, 0xfa, 0x0f, 0xb0, 0xb4,
+  0x91, 0x95, 0xc5, 0x7a, 0x7e, 0x79, 0x78, 0xfc, 0xbf, 0xb1, 0x94, 0x3d, 0x63, 0x0b, 0xf6, 0xf4,
+  0xf5, 0xa7, 0x9f, 0x3f, 0x30, 0x6b, 0xdf, 0xff, 0xe6, 0x7c, 0x6c, 0xc3, 0xdb, 0x74, 0x9f, 0x6f,
+  0x17, 0xbf, 0x0c, 0x8f, 0xa8, 0x3a, 0x9a, 0xd0, 0xb6, 0xa2, 0x93, 0x3d, 0x37, 0x9f, 0x11, 0x4a,
+  0x74, 0x85, 0x05, 0x62, 0xf4, 0x38, 0xf3, 0x04, 0x98, 0xee, 0x12, 0xdf, 0xc6, 0xb3, 0xc4, 0xaf,
+  0x86, 0xd5, 0x68, 0xa2, 0x58, 0x65, 0xb2, 0x7c, 0x2d, 0x88, 0xbd, 0xa2, 0x50, 0x1f, 0x9e, 0x94,
+  0x74, 0x82, 0xf6, 0x54, 0x92, 0x75, 0x09, 0xc2, 0x78, 0x2b, 0x30, 0x77, 0x1c, 0xec, 0xd7, 0xcf,
+  0xbb, 0xaf, 0x8d, 0xb0, 0x36, 0xff, 0x68, 0xe2, 0x31, 0x21, 0x40, 0xbd, 0x40, 0x6d, 0x50, 0x8a,
+  0x48, 0x49, 0xd1, 0x27, 0x34, 0x42, 0xa4, 0xcd, 0x61, 0xf3, 0x99, 0x51, 0x9c, 0x83, 0x21, 0xc5,
+  0x78, 0xe4, 0x8f, 0xd0, 0x27, 0xbb, 0x62, 0xe2, 0x99, 0x02, 0xc4, 0x58, 0x81, 0xae, 0xa4, 0xd0,
+  0x80, 0xd2, 0xcc, 0xfe, 0x8e, 0x6b, 0xc9, 0xc1, 0xe3, 0x72, 0x35, 0x1e, 0x2d, 0x7a, 0x9b, 0x23,
+  0xf4, 0xb6, 0x69, 0xe2, 0x11, 0x6c, 0xd3, 0x80, 0x52, 0x52, 0xf5, 0xf7, 0x34, 0x81, 0xf1, 0xe8,
+  0xce, 0x7e, 0x44, 0x68, 0x74, 0x81, 0x9a, 0xc0, 0x64, 0x12, 0xdb, 0x6b, 0xa7, 0xe5, 0x97, 0xf8,
+  0xed, 0x8d, 0xe3, 0x37, 0x7f, 0x3b, 0xfe, 0x06, 0x9e, 0x05, 0x4b, 0x2b, 0x86, 0x08, 0x00, 0x00,
+};
+constexpr web_asset_t web_index_camera = {
+  web_index_camera_gz, sizeof(web_index_camera_gz), "text/html; charset=utf-8", "\"d2581d3a6faffb78\""
+};
+
+// Control page of the ESP32-CAM robot when the camera failed (2066 bytes, 951 gzipped)
+constexpr uint8_t web_index_camera_missing_gz[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x56, 0x6d, 0x6f, 0xea, 0x36,
+  0x14, 0xfe, 0x2b, 0x5e, 0xaa, 0x0a, 0xd0, 0x6d, 0x5e, 0x80, 0xd2, 0x75, 0xce, 0x8b, 0xd4, 0xcb,
+  0x6d, 0xb7, 0xab, 0x6d, 0x6a, 0x45, 0x3b, 0x4d, 0xfb, 0x68, 0xec, 0x03, 0xf1, 0xea, 0xd8, 0x91,
+  0x6d, 0x20, 0x0c, 0xf1, 0xdf, 0x27, 0xc7, 0x50, 0x42, 0xbb, 0xfb, 0x61, 0xd2, 0xa6, 0x48, 0x09,
+  0xf1, 0xcb, 0x79, 0xce, 0xf3, 0x9c, 0xe7, 0x38, 0x64, 0xdf, 0x7d, 0x79, 0x9c, 0xbe, 0xfc, 0xf1,
+  0x74, 0x8f, 0x4a, 0x5b, 0x89, 0x22, 0x73, 0x77, 0x24, 0x88, 0x5c, 0xe6, 0x01, 0xc8, 0xa0, 0xc8,
+  0x4a, 0x20, 0xac, 0xc8, 0x2a, 0xb0, 0x04, 0xd1, 0x92, 0x68, 0x03, 0x36, 0x0f, 0x7e, 0x7b, 0x79,
+  0x08, 0x6f, 0x83, 0xc3, 0xa8, 0x24, 0x15, 0xe4, 0xc1, 0x9a, 0xc3, 0xa6, 0x56, 0xda, 0x06, 0x88,
+  0x2a, 0x69, 0x41, 0xda, 0x3c, 0xd8, 0x70, 0x66, 0xcb, 0x9c, 0xc1, 0x9a, 0x53, 0x08, 0xdb, 0x97,
+  0x2b, 0xc4, 0x25, 0xb7, 0x9c, 0x88, 0xd0, 0x50, 0x22, 0x20, 0x1f, 0x46, 0x49, 0x50, 0x64, 0x96,
+  0x5b, 0x01, 0xc5, 0xfd, 0xf3, 0xd3, 0x78, 0x14, 0x4e, 0xef, 0x7e, 0x45, 0x33, 0x35, 0x57, 0x16,
+  0x4d, 0x95, 0xb4, 0x5a, 0x89, 0x2c, 0xf6, 0xd3, 0x99, 0xb1, 0x5b, 0x01, 0xc5, 0x5c, 0xb1, 0xed,
+  0x6e, 0xa1, 0xa4, 0x0d, 0x17, 0xa4, 0xe2, 0x62, 0x8b, 0xef, 0x34, 0x27, 0xe2, 0xca, 0x10, 0x69,
+  0x42, 0x03, 0x9a, 0x2f, 0x52, 0x0b, 0x8d, 0x0d, 0x89, 0xe0, 0x4b, 0x89, 0x29, 0x48, 0x0b, 0x3a,
+  0xad, 0x88, 0x5e, 0x72, 0x89, 0x87, 0x49, 0xdd, 0xa4, 0x35, 0x61, 0x8c, 0xcb, 0x25, 0x4e, 0xd2,
+  0x39, 0xa1, 0xaf, 0x4b, 0xad, 0x56, 0x92, 0xe1, 0x8b, 0x45, 0xe2, 0xae, 0x7d, 0xe4, 0x52, 0x27,
+  0x5c, 0x82, 0xde, 0x55, 0xa4, 0xf1, 0x29, 0xe3, 0x9b, 0xc4, 0xed, 0x3b, 0xc4, 0x48, 0x10, 0x59,
+  0x59, 0xd5, 0xdd, 0xbb, 0x29, 0xb9, 0x85, 0xb7, 0xb0, 0xc3, 0x49, 0xdd, 0xa4, 0x73, 0xa5, 0x19,
+  0xe8, 0x50, 0x13, 0xc6, 0x57, 0xc6, 0xc3, 0xce, 0x55, 0x13, 0x9a, 0x92, 0x30, 0xb5, 0xc1, 0x09,
+  0x1a, 0xd5, 0x0d, 0x72, 0xa3, 0x48, 0x2f, 0xe7, 0xa4, 0x9f, 0x5c, 0xb5, 0x57, 0x34, 0x1c, 0xec,
+  0xcb, 0xe1, 0x8e, 0x2a, 0xa1, 0x34, 0xbe, 0x18, 0x8f, 0xc7, 0x07, 0xc8, 0xd0, 0xaa, 0x1a, 0x27,
+  0xfb, 0xc8, 0x58, 0x0d, 0xa4, 0x0a, 0x4f, 0x19, 0xd6, 0xca, 0x70, 0xcb, 0x95, 0xc4, 0x1a, 0x04,
+  0xb1, 0x7c, 0x0d, 0x5d, 0x9e, 0x28, 0x49, 0xd5, 0x1a, 0xf4, 0x42, 0xa8, 0x0d, 0x2e, 0x39, 0x63,
+  0x20, 0xdf, 0x65, 0x75, 0xca, 0x13, 0x0f, 0xeb, 0x06, 0x19, 0x25, 0x38, 0x43, 0x17, 0x94, 0xd2,
+  0x23, 0xd2, 0x8e, 0x71, 0x53, 0x0b, 0xb2, 0xc5, 0x73, 0xa1, 0xe8, 0x6b, 0xea, 0xb5, 0x18, 0x26,
+  0xc9, 0x65, 0x5a, 0x02, 0x5f, 0x96, 0x16, 0xb7, 0x42, 0x9c, 0xc9, 0xb2, 0x8f, 0xe6, 0x2b, 0x6b,
+  0x95, 0xdc, 0x75, 0xa5, 0xbd, 0x9e, 0xde, 0x3d, 0x4c, 0x92, 0xd4, 0xf3, 0xf2, 0x62, 0x1d, 0x70,
+  0xa5, 0x92, 0x1d, 0xe1, 0x46, 0x75, 0x73, 0x00, 0xb9, 0x4d, 0x2e, 0xd3, 0x93, 0xfc, 0xa3, 0xae,
+  0xfc, 0x93, 0xba, 0xf1, 0x05, 0x38, 0x4f, 0xae, 0xf5, 0x83, 0xe1, 0x7f, 0x01, 0x1e, 0xde, 0x7e,
+  0xd0, 0xdf, 0x31, 0xa5, 0x2b, 0x6d, 0x94, 0xc6, 0xb5, 0xe2, 0xad, 0x21, 0xac, 0x26, 0xf2, 0x20,
+  0xde, 0x29, 0x55, 0x94, 0x44, 0x63, 0x73, 0xa4, 0x80, 0x4b, 0x27, 0xdf, 0x39, 0x91, 0x09, 0x49,
+  0xae, 0x7f, 0x78, 0x5b, 0x40, 0xa8, 0xd3, 0xfc, 0x6c, 0xc5, 0x78, 0xf2, 0x3d, 0x19, 0xdf, 0x7a,
+  0x17, 0x69, 0x25, 0xcc, 0xee, 0xac, 0x20, 0xfb, 0x48, 0xab, 0xcd, 0x9b, 0xaa, 0x0b, 0x01, 0x4d,
+  0xfa, 0xe7, 0xca, 0x58, 0xbe, 0xd8, 0x86, 0x87, 0x8e, 0xc1, 0xa6, 0x26, 0x14, 0xc2, 0x39, 0xd8,
+  0x0d, 0x80, 0xec, 0x68, 0x30, 0xfe, 0x68, 0x41, 0x87, 0x22, 0x76, 0x87, 0xe9, 0xd1, 0xa5, 0xab,
+  0x1a, 0xb1, 0x2b, 0xb3, 0xeb, 0x48, 0x71, 0xed, 0x88, 0x7b, 0x3b, 0xdd, 0xdc, 0xdc, 0x74, 0xed,
+  0xe4, 0x5c, 0xba, 0xcf, 0x62, 0xdf, 0x51, 0x59, 0xec, 0x3b, 0xdc, 0x75, 0x56, 0x91, 0x31, 0xbe,
+  0x46, 0x54, 0x10, 0x63, 0xf2, 0xe0, 0xcd, 0x6a, 0xee, 0x10, 0x18, 0xbe, 0xef, 0xcf, 0x2c, 0x2e,
+  0x87, 0x67, 0xcb, 0xdf, 0x1b, 0x34, 0x40, 0x6d, 0xfc, 0x3c, 0x38, 0xf8, 0xe5, 0xc6, 0x71, 0x38,
+  0xa3, 0xdf, 0x36, 0x69, 0xc8, 0x2d, 0x54, 0xe6, 0xd8, 0xaa, 0xef, 0x15, 0xf1, 0xc3, 0x41, 0x91,
+  0xd5, 0xc7, 0x68, 0x9e, 0x91, 0x06, 0x16, 0x14, 0x53, 0x52, 0x81, 0x26, 0x48, 0x2a, 0x8b, 0xc8,
+  0x9a, 0x70, 0x41, 0xe6, 0x02, 0xb2, 0xb8, 0x2e, 0xb2, 0x98, 0xf1, 0xf5, 0x07, 0x2a, 0xae, 0x22,
+  0x41, 0x91, 0xf9, 0xf2, 0x1d, 0x27, 0xfc, 0x5b, 0x80, 0x94, 0xa4, 0x82, 0xd3, 0xd7, 0x3c, 0x30,
+  0x20, 0xd9, 0x54, 0x55, 0x15, 0x91, 0xac, 0xdf, 0x5b, 0xaa, 0xde, 0x20, 0x28, 0x1e, 0x1e, 0x67,
+  0xbf, 0xdf, 0xcd, 0xbe, 0x64, 0xb1, 0x5f, 0x7c, 0x16, 0x58, 0xab, 0x4d, 0xf0, 0x0e, 0x49, 0x7c,
+  0x13, 0xe4, 0xc0, 0xe0, 0xd4, 0x4a, 0xdf, 0xc2, 0x15, 0xb0, 0xb0, 0x0e, 0xf9, 0x97, 0xfb, 0x87,
+  0x97, 0x13, 0xec, 0x3f, 0xb0, 0xfa, 0x0f, 0xb0, 0x8c, 0x55, 0xb5, 0xc3, 0x7a, 0x7e, 0x79, 0x7c,
+  0xfa, 0xbf, 0xb1, 0xb4, 0x33, 0x82, 0x03, 0x9b, 0x7d, 0xfd, 0xf1, 0xa7, 0x0f, 0xcc, 0xfc, 0xfd,
+  0xdf, 0xd4, 0xc7, 0x35, 0x9f, 0x0b, 0xf7, 0xf9, 0x6e, 0xfa, 0xf3, 0x79, 0x89, 0xea, 0x93, 0x2b,
+  0x5d, 0x5b, 0x04, 0xc5, 0x73, 0xfb, 0xc4, 0x28, 0x33, 0x35, 0x91, 0x88, 0xb3, 0xd3, 0xcc, 0x0c,
+  0x08, 0xdb, 0x66, 0xb1, 0x1b, 0x2f, 0x3a, 0xee, 0xf1, 0x77, 0x43, 0x35, 0xaf, 0x6d, 0xb1, 0x58,
+  0x49, 0xea, 0x8e, 0x0b, 0xd4, 0x85, 0xa7, 0x15, 0x1b, 0xa0, 0x1d, 0x53, 0x74, 0x55, 0x81, 0xb4,
+  0xd1, 0x12, 0xec, 0xbd, 0x00, 0xf7, 0xf3, 0xf3, 0xf6, 0x6b, 0x2b, 0xac, 0x8b, 0xdf, 0x1b, 0x44,
+  0x5c, 0x4a, 0xd0, 0x2f, 0xd0, 0x58, 0x94, 0x23, 0x5a, 0x31, 0xf4, 0x09, 0xf5, 0x10, 0xf5, 0x31,
+  0x5c, 0x3c, 0xdb, 0x4b, 0x17, 0x60, 0x69, 0xd9, 0xef, 0xc5, 0x3d, 0xf4, 0xc9, 0xad, 0x18, 0x44,
+  0xb6, 0x04, 0xd9, 0xd7, 0x60, 0x6a, 0x25, 0x0d, 0xa0, 0xbc, 0x70, 0xdf, 0x54, 0xa3, 0x04, 0x44,
+  0x42, 0x2d, 0xfb, 0xbd, 0x69, 0x67, 0x33, 0x46, 0xc7, 0x4d, 0x83, 0x88, 0x12, 0x17, 0x06, 0xb4,
+  0x56, 0xba, 0xbb, 0xa7, 0x1d, 0xe8, 0xf7, 0xee, 0xdd, 0x03, 0xa3, 0xde, 0x15, 0x6a, 0x07, 0x06,
+  0x83, 0xd4, 0x1d, 0x01, 0x9e, 0x5f, 0x16, 0xfb, 0xee, 0x8f, 0xdb, 0xbf, 0x00, 0x7f, 0x03, 0xad,
+  0x19, 0xaa, 0xba, 0x12, 0x08, 0x00, 0x00,
+};
+constexpr web_asset_t web_index_camera_missing = {
+  web_index_camera_missing_gz, sizeof(web_index_camera_missing_gz), "text/html; charset=utf-8", "\"c4452119d6d37f98\""
+};
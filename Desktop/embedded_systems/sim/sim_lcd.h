@@ -0,0 +1,114 @@
+/**
+ * Simulated HD44780 LCD on a PCF8574 backpack for the host build
+ *
+ * An I2C device model (simAttachI2c) that decodes the expander bytes the way
+ * the display does: a nibble is latched on the falling edge of the enable
+ * line, two nibbles make a byte once the controller is in 4-bit mode. It
+ * keeps the display RAM, so a test can read back what the LCD shows, and
+ * counts what went over the bus.
+ */
+#pragma once
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/lcd_i2c.h"
+
+// ==== Display Model ====
+#define SIM_LCD_DDRAM  0x80             // Display RAM addresses (line 1 at 0x00, line 2 at 0x40)
+
+// Simulated display
+typedef struct {
+  sim_i2c_device_t device;              // Attached with simAttachI2c()
+  uint8_t last;                         // Previous expander byte (enable edge detection)
+  bool four_bit;                        // 4-bit bus selected (function set with DL = 0)
+  bool have_high;                       // High nibble of a 4-bit transfer latched
+  uint8_t high;                         // That nibble
+  bool display_on;                      // Display control D bit
+  bool backlight;                       // Backlight output of the expander
+  uint8_t address;                      // Display RAM address counter
+  char ddram[SIM_LCD_DDRAM];            // Display RAM
+  uint32_t writes;                      // I2C write transactions
+  uint32_t bytes;                       // Expander bytes written
+  uint32_t chars;                       // Characters written to the display RAM
+  uint32_t commands;                    // Instructions executed
+} sim_lcd_t;
+
+/**
+ * Execute one instruction or character
+ * @param lcd - Simulated display
+ * @param rs - Register select: true = character data
+ * @param value - Byte
+ */
+inline void simLcdExecute(sim_lcd_t *lcd, bool rs, uint8_t value) {
+  if (rs) {
+    lcd->ddram[lcd->address] = (char)value;
+    lcd->address = (lcd->address + 1) & (SIM_LCD_DDRAM - 1);
+    lcd->chars++;
+    return;
+  }
+  lcd->commands++;
+  if (value & 0x80) {
+    lcd->address = value & 0x7F;        // Set display RAM address
+  } else if (value & 0x20) {
+    lcd->four_bit = !(value & 0x10);    // Function set, DL bit
+  } else if (value & 0x08) {
+    lcd->display_on = value & 0x04;     // Display control
+  } else if (value == LCD_CMD_CLEAR) {
+    memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+    lcd->address = 0;
+  }
+}
+
+/**
+ * I2C write transaction: decode the expander bytes
+ */
+inline bool simLcdWrite(void *ctx, const uint8_t *data, size_t len) {
+  sim_lcd_t *lcd = (sim_lcd_t *)ctx;
+  lcd->writes++;
+  lcd->bytes += len;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t b = data[i];
+    lcd->backlight = b & LCD_I2C_BACKLIGHT;
+    if ((lcd->last & LCD_I2C_EN) && !(b & LCD_I2C_EN)) {
+      // Falling enable edge: D4-D7 and RS are latched
+      uint8_t nibble = lcd->last & 0xF0;
+      bool rs = lcd->last & LCD_I2C_RS;
+      if (!lcd->four_bit) {
+        simLcdExecute(lcd, rs, nibble); // 8-bit mode: D0-D3 are not wired, read as 0
+        lcd->have_high = false;
+      } else if (!lcd->have_high) {
+        lcd->high = nibble;
+        lcd->have_high = true;
+      } else {
+        simLcdExecute(lcd, rs, lcd->high | (nibble >> 4));
+        lcd->have_high = false;
+      }
+    }
+    lcd->last = b;
+  }
+  return true;
+}
+
+/**
+ * Power up a display and attach it to the I2C bus
+ * @param lcd - Simulated display
+ * @param addr - PCF8574 address
+ */
+inline void simLcdInit(sim_lcd_t *lcd, uint8_t addr) {
+  memset(lcd, 0, sizeof(*lcd));
+  memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+  lcd->device.write = simLcdWrite;
+  lcd->device.ctx = lcd;
+  simAttachI2c(addr, &lcd->device);
+}
+
+/**
+ * Characters a row shows
+ * @param lcd - Simulated display
+ * @param row - Row index
+ * @param cols - Characters to read
+ * @param text - Receives cols characters and a terminating zero
+ */
+inline void simLcdRow(const sim_lcd_t *lcd, int row, int cols, char *text) {
+  memcpy(text, lcd->ddram + (row ? 0x40 : 0), cols);
+  text[cols] = '\0';
+}
@@ -0,0 +1,89 @@
+/**
+ * Simulated HC-SR04 for the host build
+ *
+ * Watches the trigger pin through a GPIO hook and answers each ping with echo
+ * edges on the simulated clock, delivered to ultrasonicEchoEdge() the way the
+ * echo pin interrupt does on the robot. Like the real module it ignores
+ * triggers while a ping is still in flight, and holds ECHO high for hold_us
+ * when nothing reflects (38 ms on the original, up to ~200 ms on clones).
+ */
+#pragma once
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/ultrasonic.h"
+
+// ==== Sensor Model ====
+#define SIM_SONAR_BURST_US    450     // Trigger -> echo rising edge (ultrasonic burst)
+#define SIM_SONAR_US_PER_CM   58      // Echo width per centimeter of distance
+#define SIM_SONAR_NO_ECHO_US  38000   // Echo high time when nothing reflects
+
+// Simulated sensor
+typedef struct {
+  ultrasonic_t *sensor;                 // Ranging state fed with the echo edges
+  int trig_pin;                         // Trigger input of the module
+  float distance_cm;                    // Target distance, 0 = nothing in range
+  uint32_t hold_us;                     // ECHO high time when nothing reflects
+  bool busy;                            // Ping in flight (trigger ignored)
+  uint32_t pings;                       // Pings answered
+  uint32_t ignored;                     // Triggers ignored while busy
+} sim_sonar_t;
+
+/**
+ * Echo rising edge event
+ * @param ctx - Simulated sensor
+ */
+inline void simSonarRise(void *ctx) {
+  sim_sonar_t *sonar = (sim_sonar_t *)ctx;
+  ultrasonicEchoEdge(sonar->sensor, true, halMicros());
+}
+
+/**
+ * Echo falling edge event
+ * @param ctx - Simulated sensor
+ */
+inline void simSonarFall(void *ctx) {
+  sim_sonar_t *sonar = (sim_sonar_t *)ctx;
+  sonar->busy = false;
+  ultrasonicEchoEdge(sonar->sensor, false, halMicros());
+}
+
+/**
+ * GPIO hook: a falling edge on the trigger pin starts a ping
+ * @param ctx - Simulated sensor
+ * @param clear_mask - Pins driven LOW
+ * @param set_mask - Pins driven HIGH
+ */
+inline void simSonarGpio(void *ctx, uint64_t clear_mask, uint64_t set_mask) {
+  sim_sonar_t *sonar = (sim_sonar_t *)ctx;
+  (void)set_mask;
+  if (!(clear_mask & (1ULL << sonar->trig_pin))) {
+    return;
+  }
+  if (sonar->busy) {
+    sonar->ignored++;
+    return;
+  }
+  uint32_t width = sonar->distance_cm > 0 ? (uint32_t)(sonar->distance_cm * SIM_SONAR_US_PER_CM) : sonar->hold_us;
+  sonar->busy = true;
+  sonar->pings++;
+  simSchedule(SIM_SONAR_BURST_US, simSonarRise, sonar);
+  simSchedule(SIM_SONAR_BURST_US + width, simSonarFall, sonar);
+}
+
+/**
+ * Attach a simulated sensor to a ranging state and its trigger pin
+ * @param sonar - Simulated sensor
+ * @param sensor - Ranging state (ultrasonicInit() already called)
+ * @param trig_pin - Trigger pin
+ * @param distance_cm - Initial target distance, 0 = nothing in range
+ */
+inline void simSonarInit(sim_sonar_t *sonar, ultrasonic_t *sensor, int trig_pin, float distance_cm) {
+  sonar->sensor = sensor;
+  sonar->trig_pin = trig_pin;
+  sonar->distance_cm = distance_cm;
+  sonar->hold_us = SIM_SONAR_NO_ECHO_US;
+  sonar->busy = false;
+  sonar->pings = 0;
+  sonar->ignored = 0;
+  simAddGpioHook(simSonarGpio, sonar);
+}
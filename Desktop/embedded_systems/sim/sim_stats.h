@@ -0,0 +1,71 @@
+/**
+ * Result summaries for the host tests and benchmarks
+ *
+ * Collects raw samples and prints them as one table row (or CSV line) with
+ * exact percentiles, so runs can be compared over time.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+// Samples of one measured quantity
+typedef struct {
+  const char *name;                     // Metric name
+  const char *unit;                     // Unit printed after the values
+  std::vector<double> values;           // Raw samples
+} sim_stat_t;
+
+/**
+ * Percentile of the collected samples (nearest rank)
+ * @param stat - Samples, sorted
+ * @param fraction - 0.0 - 1.0
+ * @return Sample value at that rank
+ */
+inline double simPercentile(const sim_stat_t *stat, double fraction) {
+  size_t rank = (size_t)(fraction * (stat->values.size() - 1) + 0.5);
+  return stat->values[rank];
+}
+
+/**
+ * Print the table header matching simPrintStat()
+ * @param csv - CSV instead of a fixed-width table
+ */
+inline void simPrintHeader(bool csv) {
+  if (csv) {
+    printf("metric,n,min,p50,p90,p99,max,mean,unit\n");
+  } else {
+    printf("%-26s %7s %9s %9s %9s %9s %9s %9s\n", "metric", "n", "min", "p50", "p90", "p99", "max", "mean");
+  }
+}
+
+/**
+ * Print one metric (sorts its samples)
+ * @param stat - Samples
+ * @param csv - CSV instead of a fixed-width table
+ */
+inline void simPrintStat(sim_stat_t *stat, bool csv) {
+  std::vector<double> &v = stat->values;
+  if (v.empty()) {
+    if (csv) {
+      printf("%s,0,,,,,,,%s\n", stat->name, stat->unit);
+    } else {
+      printf("%-26s %7d  (no samples)\n", stat->name, 0);
+    }
+    return;
+  }
+  std::sort(v.begin(), v.end());
+  double sum = 0;
+  for (double x : v) {
+    sum += x;
+  }
+  if (csv) {
+    printf("%s,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%s\n", stat->name, v.size(), v.front(), simPercentile(stat, 0.5),
+           simPercentile(stat, 0.9), simPercentile(stat, 0.99), v.back(), sum / v.size(), stat->unit);
+  } else {
+    printf("%-26s %7zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %s\n", stat->name, v.size(), v.front(),
+           simPercentile(stat, 0.5), simPercentile(stat, 0.9), simPercentile(stat, 0.99), v.back(), sum / v.size(),
+           stat->unit);
+  }
+}
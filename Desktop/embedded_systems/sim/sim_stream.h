@@ -0,0 +1,248 @@
+/**
+ * Simulated ESP32-CAM video stream for the host build
+ *
+ * Runs the capture task and the stream sessions of Esp32_Cam_code.C on the
+ * simulated clock: the mock camera of robot_hal_linux.h produces synthetic
+ * JPEGs, and the capture decisions and per-frame bookkeeping are the ones the
+ * sketch runs (planCapture(), takeStreamFrame() and streamFrameSent() of
+ * robot_core/camera_stream.h). Only the timing is modelled here: a capture
+ * takes a fixed time once a buffer is free, and each viewer is a network link
+ * with a throughput and a fixed cost per frame whose session takes the latest
+ * frame whenever the previous send has finished.
+ */
+#pragma once
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/frame_share.h"
+#include "robot_core/camera_stream.h"
+#include "sim/sim_stats.h"
+
+// ==== Stream Model ====
+#define SIM_STREAM_VIEWERS   3        // Viewer slots (MAX_STREAM_CLIENTS)
+#define SIM_STREAM_TICK_US   500      // Simulation step
+#define SIM_STREAM_IDLE_US   50000    // Capture task sleep while nobody is watching
+
+// Network link of one viewer
+typedef struct {
+  uint32_t bytes_per_s;                 // Throughput
+  uint32_t frame_cost_us;               // Fixed cost per frame (chunk headers, TCP acknowledgement)
+} sim_link_t;
+
+// One stream session
+typedef struct {
+  stream_viewer_t *slot;                // Viewer slot (frames sent and dropped, send time)
+  sim_link_t link;                      // Network link to the viewer
+  shared_frame_t *sending;              // Frame being sent (NULL = waiting for a new one)
+  uint64_t send_start_us;               // Start of the current send
+  uint64_t done_us;                     // End of the current send
+  uint32_t sending_number;              // Number the mock camera wrote into that frame
+  uint64_t bytes;                       // JPEG bytes sent
+  uint32_t corrupted;                   // Frames overwritten while being sent
+  sim_stat_t *latency;                  // Receives capture -> sent times in ms (may be NULL)
+} sim_viewer_t;
+
+// Capture task, viewers and their counters
+typedef struct {
+  frame_share_t share;                  // Frames shared with the sessions
+  stream_pacer_t pacer;                 // Stream level
+  int fb_count;                         // Frame buffers allocated by halCameraInit()
+  uint32_t capture_us;                  // Time one capture takes
+  uint64_t next_capture_us;             // Earliest start of the next capture
+  bool capturing;                       // Capture in progress
+  uint64_t capture_done_us;             // Frame ready, 0 = waiting for a free buffer
+  stream_viewer_t slots[SIM_STREAM_VIEWERS];   // Viewer slots, as stream_viewers of the sketch
+  sim_viewer_t viewers[SIM_STREAM_VIEWERS];    // Session of each slot
+  uint32_t captures;                    // Frames captured
+  uint32_t capture_failures;            // Grabs that found no free buffer
+  uint32_t level_changes;               // Stream level changes
+} sim_stream_t;
+
+/**
+ * Frame number the mock camera wrote after the JPEG start marker
+ */
+inline uint32_t simFrameNumber(const shared_frame_t *frame) {
+  uint32_t n;
+  memcpy(&n, frame->frame.data + 2, sizeof(n));
+  return n;
+}
+
+/**
+ * Start the camera and reset the stream (calls simReset())
+ * @param stream - Stream
+ * @param fb_count - Frame buffers requested
+ * @param psram - false = single buffer like an ESP32-CAM without PSRAM
+ * @param capture_us - Time one capture takes
+ */
+inline void simStreamInit(sim_stream_t *stream, int fb_count, bool psram, uint32_t capture_us) {
+  simReset();
+  sim_camera.psram = psram;
+  memset(&stream->share, 0, sizeof(stream->share));
+  stream->pacer = {};
+  stream->fb_count = halCameraInit(fb_count, stream_levels[0].frame_size, stream_levels[0].jpeg_quality);
+  stream->capture_us = capture_us;
+  stream->next_capture_us = simNow();
+  stream->capturing = false;
+  stream->capture_done_us = 0;
+  for (int i = 0; i < SIM_STREAM_VIEWERS; i++) {
+    stream->slots[i] = {};
+    stream->viewers[i] = {};
+  }
+  stream->captures = 0;
+  stream->capture_failures = 0;
+  stream->level_changes = 0;
+}
+
+/**
+ * Connect a viewer (stream_handler() of the sketch)
+ * @param stream - Stream
+ * @param bytes_per_s - Link throughput
+ * @param frame_cost_us - Fixed cost per frame
+ * @param latency - Receives capture -> sent times in ms (may be NULL)
+ * @return The viewer, NULL if all slots are taken
+ */
+inline sim_viewer_t *simStreamAddViewer(sim_stream_t *stream, uint32_t bytes_per_s, uint32_t frame_cost_us,
+                                        sim_stat_t *latency) {
+  int slot = reserveStreamViewer(stream->slots, SIM_STREAM_VIEWERS);
+  if (slot < 0) {
+    return NULL;
+  }
+  sim_viewer_t *viewer = &stream->viewers[slot];
+  *viewer = {};
+  viewer->slot = &stream->slots[slot];
+  viewer->link.bytes_per_s = bytes_per_s;
+  viewer->link.frame_cost_us = frame_cost_us;
+  viewer->latency = latency;
+  return viewer;
+}
+
+/**
+ * Disconnect a viewer, also in the middle of a send
+ * @param viewer - Viewer from simStreamAddViewer()
+ */
+inline void simStreamRemoveViewer(sim_viewer_t *viewer) {
+  if (viewer->sending) {
+    releaseFrame(viewer->sending);
+    viewer->sending = NULL;
+  }
+  releaseStreamViewer(viewer->slot);
+}
+
+/**
+ * Capture task, one step (captureTask() of the sketch)
+ * @param stream - Stream
+ */
+inline void simStreamCapture(sim_stream_t *stream) {
+  uint64_t now = simNow();
+
+  // Capture in progress: the sensor fills a free buffer, then the frame is ready
+  if (stream->capturing) {
+    if (!stream->capture_done_us) {
+      if (sim_camera.lent_count >= stream->fb_count) {
+        return;                         // Driver waits for a buffer to come back
+      }
+      stream->capture_done_us = now + stream->capture_us;
+    }
+    if (now < stream->capture_done_us) {
+      return;
+    }
+    stream->capturing = false;
+    stream->capture_done_us = 0;
+    hal_frame_t fb;
+    if (!halCameraGrab(&fb)) {
+      stream->capture_failures++;
+      return;
+    }
+    stream->captures++;
+    shared_frame_t *frame = shareFrame(&stream->share, &fb, now);
+    if (!frame) {
+      halCameraReturn(&fb);
+      return;
+    }
+    publishFrame(&stream->share, frame);
+    return;
+  }
+
+  if (now < stream->next_capture_us) {
+    return;
+  }
+  capture_plan_t plan = planCapture(&stream->pacer, stream->slots, SIM_STREAM_VIEWERS, stream->fb_count);
+  if (plan.release_latest) {
+    publishFrame(&stream->share, NULL);
+  }
+  if (plan.viewers == 0) {
+    stream->next_capture_us = now + SIM_STREAM_IDLE_US;
+    return;
+  }
+  if (plan.level_changed) {
+    const stream_level_t *level = &stream_levels[stream->pacer.level];
+    halCameraSetLevel(level->frame_size, level->jpeg_quality);
+    stream->level_changes++;
+  }
+  stream->next_capture_us = now + plan.interval_us;
+  stream->capturing = true;
+}
+
+/**
+ * Stream session, one step (streamSessionTask() of the sketch)
+ * @param stream - Stream
+ * @param viewer - The session's viewer
+ */
+inline void simStreamSession(sim_stream_t *stream, sim_viewer_t *viewer) {
+  uint64_t now = simNow();
+  if (viewer->sending) {
+    if (now < viewer->done_us) {
+      return;
+    }
+    streamFrameSent(viewer->slot, (int32_t)(now - viewer->send_start_us));
+    if (simFrameNumber(viewer->sending) != viewer->sending_number) {
+      viewer->corrupted++;              // Buffer refilled by the camera during the send
+    }
+    viewer->bytes += viewer->sending->frame.len;
+    if (viewer->latency) {
+      viewer->latency->values.push_back((now - viewer->sending->captured_us) / 1000.0);
+    }
+    releaseFrame(viewer->sending);
+    viewer->sending = NULL;
+  }
+
+  uint32_t dropped;
+  shared_frame_t *frame = takeStreamFrame(&stream->share, viewer->slot, &dropped);
+  if (!frame) {
+    return;
+  }
+  viewer->sending = frame;
+  viewer->sending_number = simFrameNumber(frame);
+  viewer->send_start_us = now;
+  viewer->done_us = now + viewer->link.frame_cost_us + (uint64_t)frame->frame.len * 1000000 / viewer->link.bytes_per_s;
+}
+
+/**
+ * Run the stream
+ * @param stream - Stream
+ * @param duration_us - Simulated time
+ */
+inline void simStreamRun(sim_stream_t *stream, uint64_t duration_us) {
+  uint64_t end_us = simNow() + duration_us;
+  while (simNow() < end_us) {
+    simStreamCapture(stream);
+    for (int i = 0; i < SIM_STREAM_VIEWERS; i++) {
+      if (stream->slots[i].in_use) {
+        simStreamSession(stream, &stream->viewers[i]);
+      }
+    }
+    simAdvance(SIM_STREAM_TICK_US);
+  }
+}
+
+/**
+ * Disconnect all viewers and drop the latest frame (every buffer goes back to the camera)
+ * @param stream - Stream
+ */
+inline void simStreamStop(sim_stream_t *stream) {
+  for (int i = 0; i < SIM_STREAM_VIEWERS; i++) {
+    if (stream->slots[i].in_use) {
+      simStreamRemoveViewer(&stream->viewers[i]);
+    }
+  }
+  publishFrame(&stream->share, NULL);
+}
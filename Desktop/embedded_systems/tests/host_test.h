@@ -0,0 +1,40 @@
+/**
+ * Minimal checks for the host tests (no test framework needed)
+ *
+ * A failed CHECK() prints the expression and its location and the test
+ * carries on; hostTestResult() prints the summary and gives main()'s exit
+ * code, so ctest sees every failure of a run at once.
+ */
+#pragma once
+
+#include <stdio.h>
+
+int host_checks = 0;                    // Checks evaluated
+int host_failures = 0;                  // Checks that failed
+
+/**
+ * Record one check
+ * @param ok - Result
+ * @param expr - Checked expression
+ * @param file - Source file
+ * @param line - Source line
+ */
+inline void hostCheck(bool ok, const char *expr, const char *file, int line) {
+  host_checks++;
+  if (!ok) {
+    host_failures++;
+    printf("FAIL %s:%d: %s\n", file, line, expr);
+  }
+}
+
+#define CHECK(expr) hostCheck((expr), #expr, __FILE__, __LINE__)
+
+/**
+ * Print the summary
+ * @param name - Test name
+ * @return Exit code for main(): 0 = all checks passed
+ */
+inline int hostTestResult(const char *name) {
+  printf("%s: %d checks, %d failed\n", name, host_checks, host_failures);
+  return host_failures ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Host stand-in for the parts of ESP-IDF's esp_http_server.h the robot
+ * handlers use
+ *
+ * A request carries the received headers, and the response calls render
+ * HTTP/1.1 like esp_http_server does: status line, Content-Type,
+ * Content-Length, the custom headers in the order they were set, then the
+ * body. Like the real server, httpd_resp_set_hdr() keeps the pointers,
+ * not copies. A test serves the rendered bytes from a loopback socket.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/types.h>
+#include <string>
+
+typedef int esp_err_t;
+
+#define ESP_OK                       0
+#define ESP_FAIL                     -1
+#define ESP_ERR_NOT_FOUND            0x105
+#define ESP_ERR_HTTPD_RESULT_TRUNC   0xb006
+
+#define HTTPD_MAX_RESP_HEADERS       8   // CONFIG_HTTPD_MAX_RESP_HEADERS default is 8
+
+// One header of the request or the response
+typedef struct {
+  const char *field;
+  const char *value;
+} httpd_hdr_t;
+
+// Request as the handler sees it, and the response it builds
+typedef struct httpd_req {
+  char uri[512];                        // Request URI
+  std::string request_headers;          // "Field: value\r\n" lines as received
+
+  const char *status;                   // Status line text ("200 OK")
+  const char *content_type;             // Content-Type
+  httpd_hdr_t resp_headers[HTTPD_MAX_RESP_HEADERS];
+  int resp_header_count;
+  std::string response;                 // Rendered by httpd_resp_send()
+  bool sent;                            // httpd_resp_send() was called
+} httpd_req_t;
+
+/**
+ * Start a request (what the server does before it calls the handler)
+ * @param req - Request
+ * @param uri - Request URI
+ * @param headers - Request header lines, "Field: value\r\n" each
+ */
+inline void httpdReqInit(httpd_req_t *req, const char *uri, const char *headers) {
+  snprintf(req->uri, sizeof(req->uri), "%s", uri);
+  req->request_headers = headers;
+  req->status = "200 OK";
+  req->content_type = "text/html";
+  req->resp_header_count = 0;
+  req->response.clear();
+  req->sent = false;
+}
+
+inline esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *req, const char *field, char *val, size_t val_size) {
+  size_t field_len = strlen(field);
+  size_t pos = 0;
+  while (pos < req->request_headers.size()) {
+    size_t end = req->request_headers.find("\r\n", pos);
+    if (end == std::string::npos) {
+      end = req->request_headers.size();
+    }
+    std::string line = req->request_headers.substr(pos, end - pos);
+    if (line.size() > field_len && strncasecmp(line.c_str(), field, field_len) == 0 && line[field_len] == ':') {
+      size_t v = field_len + 1;
+      while (v < line.size() && line[v] == ' ') {
+        v++;
+      }
+      snprintf(val, val_size, "%s", line.c_str() + v);
+      return line.size() - v >= val_size ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+    }
+    pos = end + 2;
+  }
+  return ESP_ERR_NOT_FOUND;
+}
+
+inline esp_err_t httpd_resp_set_status(httpd_req_t *req, const char *status) {
+  req->status = status;
+  return ESP_OK;
+}
+
+inline esp_err_t httpd_resp_set_type(httpd_req_t *req, const char *type) {
+  req->content_type = type;
+  return ESP_OK;
+}
+
+inline esp_err_t httpd_resp_set_hdr(httpd_req_t *req, const char *field, const char *value) {
+  if (req->resp_header_count >= HTTPD_MAX_RESP_HEADERS) {
+    return ESP_FAIL;                    // ESP_ERR_HTTPD_RESP_HDR on the robot
+  }
+  req->resp_headers[req->resp_header_count++] = { field, value };
+  return ESP_OK;
+}
+
+inline esp_err_t httpd_resp_send(httpd_req_t *req, const char *buf, ssize_t buf_len) {
+  if (req->sent) {
+    return ESP_FAIL;
+  }
+  if (buf == NULL) {
+    buf_len = 0;
+  }
+  char line[128];
+  snprintf(line, sizeof(line), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\n", req->status,
+           req->content_type, (int)buf_len);
+  req->response = line;
+  for (int i = 0; i < req->resp_header_count; i++) {
+    req->response += std::string(req->resp_headers[i].field) + ": " + req->resp_headers[i].value + "\r\n";
+  }
+  req->response += "\r\n";
+  req->response.append(buf ? buf : "", buf_len);
+  req->sent = true;
+  return ESP_OK;
+}
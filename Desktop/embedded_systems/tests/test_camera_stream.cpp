@@ -0,0 +1,139 @@
+/**
+ * Host test of the ESP32-CAM capture pipeline on the mock camera
+ *
+ * Runs sim/sim_stream.h (capture task + stream sessions on the simulated
+ * clock, synthetic JPEGs) for a few link conditions and reports the achieved
+ * fps and the end-to-end frame latency (capture -> last byte sent) of every
+ * viewer:
+ *   good_link      one viewer on a fast link: capture-rate limited (~30 fps)
+ *   slow_and_fast  the slow viewer skips frames, the fast one keeps 30 fps
+ *   congested      the stream level steps down until the link keeps up
+ *   single_buffer  no PSRAM: capture and send take turns
+ *
+ * Usage: test_camera_stream [--csv]
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "sim/sim_stream.h"
+#include "tests/host_test.h"
+
+#define RUN_US         10000000         // Simulated time per case
+#define CAPTURE_US     8000             // Sensor readout + JPEG encoding of one frame
+#define FRAME_COST_US  3000             // Per-frame cost of a send besides the bytes
+
+sim_stream_t stream;
+bool csv = false;
+
+/**
+ * Achieved frame rate of a viewer over RUN_US
+ */
+double viewerFps(const sim_viewer_t *viewer) {
+  return viewer->slot->frames_sent * 1000000.0 / RUN_US;
+}
+
+/**
+ * Print the fps and latency of one viewer
+ * @param name - Metric name prefix
+ * @param viewer - Viewer
+ * @param latency - Its latency samples
+ */
+void report(const char *name, const sim_viewer_t *viewer, sim_stat_t *latency) {
+  char label[64];
+  snprintf(label, sizeof(label), "%s_latency", name);
+  latency->name = label;
+  simPrintStat(latency, csv);
+  if (csv) {
+    printf("%s_fps,1,,%.1f,,,,,fps\n", name, viewerFps(viewer));
+  } else {
+    printf("%-26s %7s %9s %9.1f   (%u sent, %u dropped)\n", name, "fps", "", viewerFps(viewer),
+           (unsigned)viewer->slot->frames_sent, (unsigned)viewer->slot->frames_dropped);
+  }
+}
+
+/**
+ * Every buffer must be back with the camera after the viewers left
+ */
+void checkStopped() {
+  simStreamStop(&stream);
+  CHECK(sim_camera.lent_count == 0);
+  CHECK(sim_camera.bad_returns == 0);
+}
+
+// One viewer on a link far faster than the capture
+void testGoodLink() {
+  sim_stat_t latency = { "", "ms", {} };
+  simStreamInit(&stream, 5, true, CAPTURE_US);
+  sim_viewer_t *viewer = simStreamAddViewer(&stream, 1000000, FRAME_COST_US, &latency);
+  simStreamRun(&stream, RUN_US);
+  report("good_link", viewer, &latency);
+
+  CHECK(viewerFps(viewer) >= 28 && viewerFps(viewer) <= 31);  // Paced at MIN_FRAME_INTERVAL_US
+  CHECK(viewer->slot->frames_dropped == 0);
+  CHECK(simPercentile(&latency, 0.99) < 20);  // One send after the capture, no queueing
+  CHECK(stream.level_changes == 0);
+  checkStopped();
+}
+
+// A slow viewer next to a fast one
+void testSlowAndFast() {
+  sim_stat_t fast_latency = { "", "ms", {} };
+  sim_stat_t slow_latency = { "", "ms", {} };
+  simStreamInit(&stream, 5, true, CAPTURE_US);
+  sim_viewer_t *fast = simStreamAddViewer(&stream, 1000000, FRAME_COST_US, &fast_latency);
+  sim_viewer_t *slow = simStreamAddViewer(&stream, 25000, FRAME_COST_US, &slow_latency);
+  simStreamRun(&stream, RUN_US);
+  report("slow_and_fast_fast", fast, &fast_latency);
+  report("slow_and_fast_slow", slow, &slow_latency);
+
+  CHECK(viewerFps(fast) >= 28);         // Not held up by the slow viewer
+  CHECK(fast->slot->frames_dropped == 0);
+  CHECK(viewerFps(slow) >= 5 && viewerFps(slow) <= 7);  // ~3.9 KB frames at 25 KB/s
+  CHECK(slow->slot->frames_dropped > slow->slot->frames_sent);    // Skips to the latest frame
+  CHECK(simPercentile(&slow_latency, 0.99) < 250);  // Send time + at most one capture interval
+  CHECK(stream.level_changes == 0);     // Quality follows the fastest viewer
+  CHECK(stream.capture_failures == 0);
+  checkStopped();
+}
+
+// The only viewer's link cannot carry the default level
+void testCongested() {
+  sim_stat_t latency = { "", "ms", {} };
+  simStreamInit(&stream, 5, true, CAPTURE_US);
+  sim_viewer_t *viewer = simStreamAddViewer(&stream, 30000, FRAME_COST_US, &latency);
+  simStreamRun(&stream, RUN_US);
+  report("congested", viewer, &latency);
+
+  CHECK(stream.pacer.level == 2);       // Stepped down until a frame takes 40-100 ms
+  CHECK(stream.level_changes == 2);     // No oscillation
+  CHECK(viewerFps(viewer) >= 8);        // ~11 fps once adapted
+  CHECK(simPercentile(&latency, 0.5) < 130);
+  checkStopped();
+}
+
+// ESP32-CAM without PSRAM
+void testSingleBuffer() {
+  sim_stat_t latency = { "", "ms", {} };
+  simStreamInit(&stream, 5, false, CAPTURE_US);
+  CHECK(stream.fb_count == 1);
+  sim_viewer_t *viewer = simStreamAddViewer(&stream, 100000, FRAME_COST_US, &latency);
+  simStreamRun(&stream, RUN_US);
+  report("single_buffer", viewer, &latency);
+
+  // Capture (8 ms) waits for each send (~42 ms): ~20 fps instead of the ~24 fps
+  // the send time alone would allow
+  CHECK(viewerFps(viewer) >= 18 && viewerFps(viewer) <= 21);
+  CHECK(sim_camera.max_lent == 1);
+  CHECK(viewer->slot->frames_dropped == 0);
+  checkStopped();
+}
+
+int main(int argc, char **argv) {
+  csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+  simPrintHeader(csv);
+  testGoodLink();
+  testSlowAndFast();
+  testCongested();
+  testSingleBuffer();
+  return hostTestResult("test_camera_stream");
+}
@@ -0,0 +1,131 @@
+/**
+ * Host test of robot_core/frame_share.h on the mock camera
+ *
+ * Runs the capture task and the stream sessions of sim/sim_stream.h (the
+ * capture and session steps of the sketch) with viewers modelled by their
+ * send time:
+ *   - a fast and a slow viewer: the fast one gets every frame, the slow one
+ *     skips frames without holding up the fast one or the capture
+ *   - a viewer disconnecting while it holds a frame
+ *   - the single-buffer path (no PSRAM): the capture waits for the viewer
+ * Every case also checks that no buffer is overwritten while a viewer sends
+ * it, returned twice, or leaked.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "sim/sim_stream.h"
+#include "tests/host_test.h"
+
+#define CAPTURE_US  8000                // Sensor readout + JPEG encoding of one frame
+
+sim_stream_t stream;
+
+/**
+ * Connect a viewer that takes a fixed time per frame, whatever its size
+ * @param send_us - Time to send one frame
+ */
+sim_viewer_t *addViewer(uint32_t send_us) {
+  return simStreamAddViewer(&stream, UINT32_MAX, send_us, NULL);
+}
+
+/**
+ * Viewers hang up, the capture stops: every buffer must be back with the driver
+ */
+void checkAllReturned() {
+  simStreamStop(&stream);
+  CHECK(sim_camera.lent_count == 0);
+  CHECK(sim_camera.bad_returns == 0);
+  for (int i = 0; i < FRAME_SHARE_SLOTS; i++) {
+    CHECK(stream.share.pool[i].frame.data == NULL);
+  }
+}
+
+// A 30 fps link and a 150 ms link watching the same stream
+void testSlowAndFastViewer() {
+  simStreamInit(&stream, 4, true, CAPTURE_US);  // Two viewers + latest + one filling
+  CHECK(stream.fb_count == 4);
+
+  sim_viewer_t *fast = addViewer(10000);
+  sim_viewer_t *slow = addViewer(150000);
+  simStreamRun(&stream, 3000000);
+
+  printf("slow/fast: fast %u sent %u dropped, slow %u sent %u dropped, %d buffers lent at most\n",
+         (unsigned)fast->slot->frames_sent, (unsigned)fast->slot->frames_dropped,
+         (unsigned)slow->slot->frames_sent, (unsigned)slow->slot->frames_dropped, sim_camera.max_lent);
+  CHECK(stream.capture_failures == 0);  // The slow viewer never starves the capture
+  CHECK(stream.captures >= 88);         // ~3 s at 30 fps
+  CHECK(fast->slot->frames_dropped == 0);
+  CHECK(fast->slot->frames_sent >= 88);
+  CHECK(slow->slot->frames_sent >= 16 && slow->slot->frames_sent <= 20);  // 150 ms send + wait for the next frame
+  CHECK(slow->slot->frames_dropped >= 60);  // Latest frame wins
+  CHECK(fast->corrupted == 0 && slow->corrupted == 0);
+  CHECK(sim_camera.max_lent <= stream.fb_count);
+  checkAllReturned();
+}
+
+// A viewer hangs up in the middle of a send
+void testDisconnectWhileHolding() {
+  simStreamInit(&stream, 5, true, CAPTURE_US);
+  sim_viewer_t *leaving = addViewer(100000);
+  sim_viewer_t *staying = addViewer(20000);
+
+  // Frame is still the latest: the broadcaster keeps it for the other viewers
+  simStreamRun(&stream, 20000);         // First frame published at 8 ms
+  shared_frame_t *held = leaving->sending;
+  CHECK(held != NULL && held == stream.share.latest);
+  int refs = held->refs;
+  simStreamRemoveViewer(leaving);
+  CHECK(held->refs == refs - 1 && held->frame.data != NULL);
+  CHECK(!stream.slots[0].in_use);
+  CHECK(acquireLatestFrame(&stream.share, held->seq) == NULL);  // Nothing new for a reconnect
+
+  // Newer frames were published meanwhile: the held buffer goes straight back
+  leaving = addViewer(100000);
+  CHECK(leaving == &stream.viewers[0]); // Slot reused
+  simStreamRun(&stream, 50000);
+  held = leaving->sending;
+  CHECK(held != NULL && held != stream.share.latest && held->refs == 1);
+  int lent = sim_camera.lent_count;
+  simStreamRemoveViewer(leaving);
+  CHECK(held->frame.data == NULL);
+  CHECK(sim_camera.lent_count == lent - 1);
+
+  // The stream carries on for the viewer that stays
+  uint32_t sent = staying->slot->frames_sent;
+  simStreamRun(&stream, 500000);
+  CHECK(staying->slot->frames_sent - sent >= 14);
+  CHECK(staying->slot->frames_dropped == 0 && staying->corrupted == 0);
+  checkAllReturned();
+}
+
+// ESP32-CAM without PSRAM: one frame buffer in DRAM
+void testSingleBuffer() {
+  simStreamInit(&stream, 5, false, CAPTURE_US);
+  CHECK(stream.fb_count == 1);
+
+  // A viewer slower than the capture interval: captures wait for it, nothing is corrupted
+  sim_viewer_t *viewer = addViewer(50000);
+  simStreamRun(&stream, 1000000);
+  printf("single buffer: %u captured, %u sent, %u dropped\n", (unsigned)stream.captures,
+         (unsigned)viewer->slot->frames_sent, (unsigned)viewer->slot->frames_dropped);
+  CHECK(viewer->slot->frames_sent >= 15);
+  CHECK(viewer->slot->frames_dropped == 0);
+  CHECK(viewer->corrupted == 0);
+  CHECK(stream.capture_failures == 0);
+  CHECK(sim_camera.max_lent == 1);
+
+  // The published frame is dropped before each capture: the buffer is only
+  // out while the viewer sends it
+  simStreamRemoveViewer(viewer);
+  simStreamRun(&stream, SIM_STREAM_IDLE_US + SIM_STREAM_TICK_US);
+  CHECK(stream.share.latest == NULL && sim_camera.lent_count == 0);
+  checkAllReturned();
+}
+
+int main() {
+  testSlowAndFastViewer();
+  testDisconnectWhileHolding();
+  testSingleBuffer();
+  return hostTestResult("test_frame_share");
+}
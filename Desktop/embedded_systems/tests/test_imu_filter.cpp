@@ -0,0 +1,277 @@
+/**
+ * Host test of robot_core/imu_filter.h on a MPU6050 trace
+ *
+ *   - classifyTilt() hysteresis: enter and exit thresholds of both axes,
+ *     forward/back before turning, proportional speed
+ *   - single-sample spikes (taps) neither start nor stop a command
+ *   - replay of tests/data/imu_trace.csv through updateTiltFilter() and
+ *     classifyTilt() as imuTask does: exactly the expected command sequence,
+ *     compared with the old raw-threshold classifier
+ *   - per-sample cost of filter + classifier (host CPU), printed as a table
+ *
+ * Usage: test_imu_filter [--csv] [--passes N] [trace.csv]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "robot_core/imu_filter.h"
+#include "sim/sim_stats.h"
+#include "tests/host_test.h"
+
+#define TRACE_RATE_HZ  200              // IMU_SAMPLE_RATE_HZ of FOR_IMU_CODE.C
+#define TRACE_DT       (1.0f / TRACE_RATE_HZ)
+
+// One line of the trace
+typedef struct {
+  uint32_t t_ms;                        // Time since the start of the trace
+  imu_sample_t sample;                  // Raw FIFO sample
+} trace_sample_t;
+
+std::vector<trace_sample_t> trace;
+
+/**
+ * Load a trace (t_ms,ax,ay,az,gx,gy,gz per line, # comments and a header)
+ * @param path - CSV file
+ * @return false if the file could not be read
+ */
+bool loadTrace(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    return false;
+  }
+  char line[128];
+  while (fgets(line, sizeof(line), f)) {
+    trace_sample_t s;
+    int v[6];
+    unsigned t;
+    if (sscanf(line, "%u,%d,%d,%d,%d,%d,%d", &t, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == 7) {
+      s.t_ms = t;
+      s.sample = { (int16_t)v[0], (int16_t)v[1], (int16_t)v[2], (int16_t)v[3], (int16_t)v[4], (int16_t)v[5] };
+      trace.push_back(s);
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+/**
+ * Filter state holding a given tilt
+ */
+tilt_filter_t tilt(float forward_deg, float right_deg) {
+  tilt_filter_t filter = { -forward_deg, -right_deg, true };
+  return filter;
+}
+
+/**
+ * Command for a tilt, given the command being sent
+ */
+uint8_t classify(float forward_deg, float right_deg, uint8_t current) {
+  tilt_filter_t filter = tilt(forward_deg, right_deg);
+  return classifyTilt(&filter, current).command;
+}
+
+// Enter above the high threshold, hold down to the low one
+void testHysteresis() {
+  for (float f : { 0.0f, 20.0f, 30.0f, 34.9f }) {
+    CHECK(classify(f, 0, CONTROL_STOP) == CONTROL_STOP);
+    CHECK(classify(-f, 0, CONTROL_STOP) == CONTROL_STOP);
+  }
+  CHECK(classify(35.5f, 0, CONTROL_STOP) == CONTROL_GO);
+  CHECK(classify(-35.5f, 0, CONTROL_STOP) == CONTROL_BACK);
+  CHECK(classify(30, 0, CONTROL_GO) == CONTROL_GO);         // Between exit and enter: held
+  CHECK(classify(25.5f, 0, CONTROL_GO) == CONTROL_GO);
+  CHECK(classify(24.5f, 0, CONTROL_GO) == CONTROL_STOP);
+  CHECK(classify(-30, 0, CONTROL_BACK) == CONTROL_BACK);
+  CHECK(classify(-24.5f, 0, CONTROL_BACK) == CONTROL_STOP);
+
+  CHECK(classify(0, 27, CONTROL_STOP) == CONTROL_STOP);
+  CHECK(classify(0, 28.5f, CONTROL_STOP) == CONTROL_RIGHT);
+  CHECK(classify(0, -28.5f, CONTROL_STOP) == CONTROL_LEFT);
+  CHECK(classify(0, 20, CONTROL_RIGHT) == CONTROL_RIGHT);
+  CHECK(classify(0, 17.5f, CONTROL_RIGHT) == CONTROL_STOP);
+  CHECK(classify(0, -20, CONTROL_LEFT) == CONTROL_LEFT);
+  CHECK(classify(0, -17.5f, CONTROL_LEFT) == CONTROL_STOP);
+
+  // Direction change straight through: the old command's exit, the new one's enter
+  CHECK(classify(-40, 0, CONTROL_GO) == CONTROL_BACK);
+  CHECK(classify(40, 0, CONTROL_RIGHT) == CONTROL_GO);      // Right released (18 deg exit not met)
+  CHECK(classify(40, 30, CONTROL_STOP) == CONTROL_GO);      // Forward/back before turning
+  CHECK(classify(40, 30, CONTROL_RIGHT) == CONTROL_RIGHT);  // A held turn is not taken over
+
+  // Speed: MIN_DRIVE_SPEED at the exit threshold, 255 from FULL_SPEED_DEG
+  tilt_filter_t filter = tilt(30, 0);
+  CHECK(classifyTilt(&filter, CONTROL_GO).speed == tiltToSpeed(30, DRIVE_EXIT_DEG));
+  CHECK(tiltToSpeed(DRIVE_EXIT_DEG, DRIVE_EXIT_DEG) == MIN_DRIVE_SPEED);
+  CHECK(tiltToSpeed(FULL_SPEED_DEG, DRIVE_EXIT_DEG) == 255);
+  CHECK(tiltToSpeed(80, TURN_EXIT_DEG) == 255);
+  filter = tilt(0, 0);
+  CHECK(classifyTilt(&filter, CONTROL_STOP).speed == 0);
+}
+
+/**
+ * Raw sample of a steady tilt about X (forward positive), no rotation
+ */
+imu_sample_t steadySample(float forward_deg) {
+  float rad = -forward_deg / 57.2957795f;
+  imu_sample_t s = { 0, (int16_t)(sinf(rad) * IMU_ACCEL_LSB_PER_G), (int16_t)(cosf(rad) * IMU_ACCEL_LSB_PER_G), 0, 0, 0 };
+  return s;
+}
+
+/**
+ * Settle the filter on a steady tilt, then feed one tap and let it settle again
+ * @param forward_deg - Steady tilt
+ * @param current - Command before the tap
+ * @param tap - The spike sample
+ * @return Number of samples whose command differed from current
+ */
+int feedTap(float forward_deg, uint8_t current, imu_sample_t tap) {
+  tilt_filter_t filter = {};
+  imu_sample_t steady = steadySample(forward_deg);
+  tilt_command_t command = { current, 0 };
+  for (int i = 0; i < 400; i++) {
+    updateTiltFilter(&filter, &steady, TRACE_DT);
+  }
+  int changed = 0;
+  for (int i = 0; i < 200; i++) {
+    updateTiltFilter(&filter, i == 0 ? &tap : &steady, TRACE_DT);
+    command = classifyTilt(&filter, command.command);
+    changed += command.command != current;
+  }
+  return changed;
+}
+
+// A tap (accelerometer spike plus a gyro kick for one sample) changes nothing
+void testSpikeRejection() {
+  imu_sample_t tap = steadySample(32);
+  tap.ay -= 15000;                      // ~0.9 g towards forward
+  tap.gx = -32000;                      // Gyro near full scale (-244 dps)
+  CHECK(feedTap(32, CONTROL_STOP, tap) == 0);   // 3 deg below the enter threshold
+
+  tap = steadySample(28);
+  tap.ay += 15000;
+  tap.gx = 32000;
+  CHECK(feedTap(28, CONTROL_GO, tap) == 0);     // 3 deg above the exit threshold
+
+  // The old raw threshold (AY < -10000 = go) took the same tap as a command
+  imu_sample_t raw = steadySample(32);
+  raw.ay -= 15000;
+  CHECK(raw.ay < -10000);
+}
+
+/**
+ * Command of the old remote: raw accelerometer thresholds, no filtering
+ */
+uint8_t rawThresholdCommand(const imu_sample_t *s) {
+  if (s->ay < -10000) return CONTROL_GO;
+  if (s->ay > 10000) return CONTROL_BACK;
+  if (s->ax > 8000) return CONTROL_RIGHT;
+  if (s->ax < -8000) return CONTROL_LEFT;
+  return CONTROL_STOP;
+}
+
+/**
+ * Command sent at a point of the replay
+ */
+uint8_t commandAt(const std::vector<uint8_t> &commands, uint32_t t_ms) {
+  return commands[t_ms * TRACE_RATE_HZ / 1000];
+}
+
+// The recorded gestures give exactly their commands, without flicker
+void testTraceReplay() {
+  tilt_filter_t filter = {};
+  tilt_command_t command = { CONTROL_STOP, 0 };
+  std::vector<uint8_t> commands;
+  std::vector<uint8_t> sequence = { CONTROL_STOP };
+  int raw_changes = 0;
+  uint8_t raw_last = CONTROL_STOP;
+  for (const trace_sample_t &s : trace) {
+    updateTiltFilter(&filter, &s.sample, TRACE_DT);
+    command = classifyTilt(&filter, command.command);
+    commands.push_back(command.command);
+    if (command.command != sequence.back()) {
+      sequence.push_back(command.command);
+    }
+    uint8_t raw = rawThresholdCommand(&s.sample);
+    raw_changes += raw != raw_last;
+    raw_last = raw;
+  }
+  printf("trace: %zu samples, %zu command changes (raw thresholds: %d)\n", trace.size(), sequence.size() - 1,
+         raw_changes);
+
+  std::vector<uint8_t> expected = { CONTROL_STOP, CONTROL_GO, CONTROL_STOP, CONTROL_RIGHT, CONTROL_STOP,
+                                    CONTROL_BACK, CONTROL_STOP };
+  CHECK(sequence == expected);
+  CHECK(raw_changes > (int)expected.size());  // The taps flip the raw classifier
+  CHECK(commandAt(commands, 500) == CONTROL_STOP);   // Tap at rest
+  CHECK(commandAt(commands, 2000) == CONTROL_GO);    // Tap while driving
+  CHECK(commandAt(commands, 3000) == CONTROL_GO);    // Hover at 30 deg: held
+  CHECK(commandAt(commands, 4500) == CONTROL_STOP);  // Same hover from level, with a tap: not started
+  CHECK(commandAt(commands, 5700) == CONTROL_RIGHT);
+  CHECK(commandAt(commands, 7000) == CONTROL_BACK);
+  CHECK(commandAt(commands, 7900) == CONTROL_STOP);
+}
+
+/**
+ * Nanoseconds of the host's monotonic clock
+ */
+uint64_t monotonicNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Filter + classifier cost per sample: one value per pass over the trace
+ * @param passes - Passes over the trace
+ * @param per_sample - Receives the average time per sample of each pass
+ */
+void benchPerSample(int passes, sim_stat_t *per_sample) {
+  volatile uint8_t sink = 0;            // Keeps the classifier from being optimized away
+  for (int p = 0; p < passes; p++) {
+    tilt_filter_t filter = {};
+    tilt_command_t command = { CONTROL_STOP, 0 };
+    uint64_t start = monotonicNs();
+    for (const trace_sample_t &s : trace) {
+      updateTiltFilter(&filter, &s.sample, TRACE_DT);
+      command = classifyTilt(&filter, command.command);
+    }
+    per_sample->values.push_back((double)(monotonicNs() - start) / trace.size());
+    sink = sink + command.command;
+  }
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  int passes = 200;
+  const char *path = "tests/data/imu_trace.csv";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+      passes = atoi(argv[++i]);
+    } else if (argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--passes N] [trace.csv]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!loadTrace(path) || trace.empty()) {
+    fprintf(stderr, "Cannot read the IMU trace %s\n", path);
+    return 2;
+  }
+
+  testHysteresis();
+  testSpikeRejection();
+  testTraceReplay();
+
+  sim_stat_t per_sample = { "tilt_filter_ns_per_sample", "ns", {} };
+  benchPerSample(passes, &per_sample);
+  simPrintHeader(csv);
+  simPrintStat(&per_sample, csv);
+
+  return hostTestResult("test_imu_filter");
+}
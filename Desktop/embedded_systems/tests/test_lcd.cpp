@@ -0,0 +1,226 @@
+/**
+ * Host test of the LCD path of the IMU remote: renderLcdRow()
+ * (robot_core/lcd_renderer.h) drawing through lcd_i2c.h onto the simulated
+ * HD44780 of sim/sim_lcd.h
+ *
+ *   - lcdI2cInit() leaves the controller in 4-bit mode, display on, cleared
+ *   - the first frame writes only its non-blank cells, an unchanged frame
+ *     writes nothing, a changed digit costs one cursor move and one character
+ *   - after every frame of a remote session the display shows the frame
+ *   - bus bytes and bus time per frame against a full redraw of both rows,
+ *     printed as a table
+ *
+ * Usage: test_lcd [--csv] [--frames N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/lcd_i2c.h"
+#include "robot_core/lcd_renderer.h"
+#include "robot_core/robot_protocol.h"
+#include "sim/sim_lcd.h"
+#include "sim/sim_stats.h"
+#include "tests/host_test.h"
+
+#define LCD_ADDR        0x27            // LCD_I2C_ADDR of FOR_IMU_CODE.C
+#define I2C_FREQ_HZ     100000          // Bus clock of the remote
+#define BYTES_PER_SEND  5               // Address byte + four expander bytes
+
+lcd_i2c_t lcd;
+sim_lcd_t sim_lcd;
+lcd_frame_t shown;                      // lcdTask's shadow copy
+
+/**
+ * The two rows loop() puts on the display
+ */
+void remoteFrame(lcd_frame_t *frame, uint8_t command, uint8_t speed, int roll, int pitch) {
+  char line[LCD_COLS + 1];
+  snprintf(line, sizeof(line), "%-5s speed:%3u", controlCommandName(command), speed);
+  setLcdRow(frame, 0, line);
+  snprintf(line, sizeof(line), "R:%4d P:%4d", roll, pitch);
+  setLcdRow(frame, 1, line);
+}
+
+/**
+ * True if the simulated display shows the frame
+ */
+bool displayShows(const lcd_frame_t *frame) {
+  for (int row = 0; row < LCD_ROWS; row++) {
+    char text[LCD_COLS + 1];
+    simLcdRow(&sim_lcd, row, LCD_COLS, text);
+    if (memcmp(text, frame->cells[row], LCD_COLS) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Draw a frame like lcdTask, row by row
+ * @param target - Frame to show
+ * @param cells - Receives the characters written per row (may be NULL)
+ * @return Characters written
+ */
+int renderFrame(const lcd_frame_t *target, int *cells) {
+  int written = 0;
+  for (int row = 0; row < LCD_ROWS; row++) {
+    int n = renderLcdRow(&lcd, lcdI2cSetCursor, lcdI2cWrite, &shown, target, row);
+    if (cells) {
+      cells[row] = n;
+    }
+    written += n;
+  }
+  return written;
+}
+
+// Power-up sequence of setup()
+void testInit() {
+  simReset();
+  simLcdInit(&sim_lcd, LCD_ADDR);
+  halI2cBegin(21, 22, I2C_FREQ_HZ);
+  memset(sim_lcd.ddram, '#', sizeof(sim_lcd.ddram));   // Garbage from before the reset
+  CHECK(lcdI2cInit(&lcd, LCD_ADDR));
+  CHECK(sim_lcd.four_bit && !sim_lcd.have_high);
+  CHECK(sim_lcd.display_on && sim_lcd.backlight);
+  CHECK(sim_lcd.address == 0 && sim_lcd.chars == 0);
+  lcd_frame_t blank;
+  clearLcdFrame(&blank);
+  CHECK(displayShows(&blank));
+  CHECK(sim_lcd.writes == 8);           // Four reset nibbles + four instructions
+
+  lcdI2cSetCursor(&lcd, 0, 1);
+  lcdI2cPrint(&lcd, "IMU connected");
+  char text[LCD_COLS + 1];
+  simLcdRow(&sim_lcd, 1, LCD_COLS, text);
+  CHECK(strcmp(text, "IMU connected   ") == 0);
+
+  lcdI2cClear(&lcd);                    // End of setup()
+  CHECK(displayShows(&blank));
+
+  lcd_i2c_t missing = {};
+  CHECK(!lcdI2cInit(&missing, 0x3F));  // No backpack at that address
+}
+
+// What lcdTask writes for the first, an unchanged and a slightly changed frame
+void testFrameCosts() {
+  clearLcdFrame(&shown);
+  lcd_frame_t frame;
+  remoteFrame(&frame, CONTROL_STOP, 0, 0, 0);   // "stop  speed:  0" / "R:   0 P:   0"
+
+  uint32_t bytes = sim_i2c_bytes;
+  uint32_t chars = sim_lcd.chars;
+  int cells[LCD_ROWS];
+  int written = renderFrame(&frame, cells);
+  printf("first frame: %d + %d cells, %u bus bytes\n", cells[0], cells[1], (unsigned)(sim_i2c_bytes - bytes));
+  CHECK(cells[0] == 11 && cells[1] == 6);       // Non-blank cells only
+  CHECK(sim_lcd.chars - chars == (uint32_t)written);
+  CHECK(displayShows(&frame));
+
+  // Same frame again: no I2C traffic at all
+  bytes = sim_i2c_bytes;
+  uint32_t writes = sim_i2c_transactions;
+  CHECK(renderFrame(&frame, NULL) == 0);
+  CHECK(sim_i2c_bytes == bytes && sim_i2c_transactions == writes);
+
+  // Speed 0 -> 5: one cursor move and one character
+  remoteFrame(&frame, CONTROL_STOP, 5, 0, 0);
+  bytes = sim_i2c_bytes;
+  writes = sim_i2c_transactions;
+  CHECK(renderFrame(&frame, NULL) == 1);
+  CHECK(sim_i2c_transactions - writes == 2);
+  CHECK(sim_i2c_bytes - bytes == 2 * BYTES_PER_SEND);
+  CHECK(displayShows(&frame));
+
+  // Two separate runs on one row: two cursor moves
+  remoteFrame(&frame, CONTROL_GO, 128, 0, 0);   // "go    speed:128"
+  writes = sim_i2c_transactions;
+  written = renderFrame(&frame, NULL);
+  CHECK(sim_i2c_transactions - writes == (uint32_t)written + 2);
+  CHECK(displayShows(&frame));
+}
+
+/**
+ * A remote session: command and speed change now and then, the tilt angles
+ * wander by a few degrees between LCD refreshes
+ * @param frames - Frames drawn
+ * @param diff_bytes - Receives bus bytes per frame of renderLcdRow()
+ * @param full_bytes - Receives bus bytes per frame of a full redraw
+ * @param diff_us - Receives bus time per frame of renderLcdRow()
+ * @param full_us - Receives bus time per frame of a full redraw
+ */
+void runSession(int frames, sim_stat_t *diff_bytes, sim_stat_t *full_bytes, sim_stat_t *diff_us,
+                sim_stat_t *full_us) {
+  std::mt19937 rng(7);
+  uint8_t command = CONTROL_STOP;
+  int speed = 0;
+  int roll = 0;
+  int pitch = 0;
+  int mismatches = 0;
+  for (int i = 0; i < frames; i++) {
+    if (rng() % 10 == 0) {
+      command = rng() % CONTROL_COMMAND_COUNT;
+    }
+    speed = command == CONTROL_STOP ? 0 : 80 + rng() % 176;
+    roll += (int)(rng() % 7) - 3;
+    pitch += (int)(rng() % 5) - 2;
+    lcd_frame_t frame;
+    remoteFrame(&frame, command, speed, roll, pitch);
+
+    uint32_t bytes = sim_i2c_bytes;
+    uint64_t start = simNow();
+    renderFrame(&frame, NULL);
+    diff_bytes->values.push_back(sim_i2c_bytes - bytes);
+    diff_us->values.push_back((double)(simNow() - start));
+    mismatches += !displayShows(&frame);
+
+    // The same frame drawn the old way: both rows in full
+    bytes = sim_i2c_bytes;
+    start = simNow();
+    for (int row = 0; row < LCD_ROWS; row++) {
+      lcdI2cSetCursor(&lcd, 0, row);
+      for (int col = 0; col < LCD_COLS; col++) {
+        lcdI2cWrite(&lcd, frame.cells[row][col]);
+      }
+    }
+    full_bytes->values.push_back(sim_i2c_bytes - bytes);
+    full_us->values.push_back((double)(simNow() - start));
+    mismatches += !displayShows(&frame);
+  }
+  CHECK(mismatches == 0);
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  int frames = 500;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frames = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--frames N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  testInit();
+  testFrameCosts();
+
+  sim_stat_t diff_bytes = { "lcd_diff_bytes_per_frame", "B", {} };
+  sim_stat_t full_bytes = { "lcd_full_bytes_per_frame", "B", {} };
+  sim_stat_t diff_us = { "lcd_diff_bus_us_per_frame", "us", {} };
+  sim_stat_t full_us = { "lcd_full_bus_us_per_frame", "us", {} };
+  runSession(frames, &diff_bytes, &full_bytes, &diff_us, &full_us);
+  simPrintHeader(csv);
+  simPrintStat(&diff_bytes, csv);
+  simPrintStat(&full_bytes, csv);
+  simPrintStat(&diff_us, csv);
+  simPrintStat(&full_us, csv);
+  CHECK(full_bytes.values.front() == 2 * (LCD_COLS + 1) * BYTES_PER_SEND);
+  CHECK(simPercentile(&diff_bytes, 0.9) < full_bytes.values.front() / 2);
+
+  return hostTestResult("test_lcd");
+}
@@ -0,0 +1,274 @@
+/**
+ * Host test of the motor output table (robot_core/motor_driver.h) and the
+ * command mailbox (robot_core/robot_control.h)
+ *
+ *   - motor_table: checked at compile time (static_assert) and on the pins:
+ *     one GPIO write per command, IN1 and IN2 of a motor never HIGH together,
+ *     enable duty only written when it changes (and again after motorInit()),
+ *     unknown commands stop
+ *   - mailbox: the latest post wins, command and speed are never torn apart
+ *     by a concurrent post, one latency sample per post
+ *   - command-to-output microbenchmark: postCommand() + controlStep() until
+ *     the pattern is on the pins, and applyMotorCommand() alone (CPU time)
+ *
+ * Usage: test_motor [--csv] [--rounds N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+
+// Pins of the ESP32 robot (Motor_Esp_32_Code.C)
+#define MOTOR_A_IN1 2
+#define MOTOR_A_IN2 12
+#define MOTOR_B_IN1 13
+#define MOTOR_B_IN2 15
+#define MOTOR_A_EN  26
+#define MOTOR_B_EN  27
+#define TRIG_PIN    14
+#define BUZZER_PIN  25
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/robot_control.h"
+#include "sim/sim_sonar.h"
+#include "sim/sim_stats.h"
+#include "tests/host_test.h"
+
+#define PWM_UNTOUCHED  0xDEAD           // Duty marker: no PWM write since it was set
+
+// ==== Compile-time Table Checks ====
+constexpr uint32_t A_FWD = 1U << MOTOR_A_IN1;
+constexpr uint32_t A_REV = 1U << MOTOR_A_IN2;
+constexpr uint32_t B_FWD = 1U << MOTOR_B_IN1;
+constexpr uint32_t B_REV = 1U << MOTOR_B_IN2;
+
+static_assert(motor_table[CONTROL_STOP].set_mask == 0 && !motor_table[CONTROL_STOP].a_on &&
+              !motor_table[CONTROL_STOP].b_on, "STOP drives nothing");
+static_assert(motor_table[CONTROL_GO].set_mask == (A_FWD | B_FWD), "GO: both forward");
+static_assert(motor_table[CONTROL_BACK].set_mask == (A_REV | B_REV), "BACK: both backward");
+static_assert(motor_table[CONTROL_LEFT].set_mask == (A_REV | B_FWD), "LEFT: A backward, B forward");
+static_assert(motor_table[CONTROL_RIGHT].set_mask == (A_FWD | B_REV), "RIGHT: A forward, B backward");
+
+/**
+ * No pattern drives both inputs of a motor, and only the motor pins
+ */
+constexpr bool tableIsSafe() {
+  for (int c = 0; c < CONTROL_COMMAND_COUNT; c++) {
+    uint32_t m = motor_table[c].set_mask;
+    if (((m & A_FWD) && (m & A_REV)) || ((m & B_FWD) && (m & B_REV)) || (m & ~MOTOR_PIN_MASK)) {
+      return false;
+    }
+    if (motor_table[c].a_on != ((m & (A_FWD | A_REV)) != 0) || motor_table[c].b_on != ((m & (B_FWD | B_REV)) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(tableIsSafe(), "motor_table drives IN1 and IN2 of a motor together");
+
+// Motor pin writes seen on the GPIO recorder
+typedef struct {
+  uint32_t writes;                      // Writes touching a motor pin
+  uint32_t shoot_through;               // Writes after which IN1 and IN2 of a motor were both HIGH
+} motor_log_t;
+
+robot_control_t robot;
+ultrasonic_t sonar;
+sim_sonar_t sim_sonar;
+motor_log_t motor_log;
+
+/**
+ * GPIO hook: count motor pin writes and check the levels after each one
+ */
+void motorHook(void *ctx, uint64_t clear_mask, uint64_t set_mask) {
+  motor_log_t *log = (motor_log_t *)ctx;
+  if (!((clear_mask | set_mask) & MOTOR_PIN_MASK)) {
+    return;
+  }
+  log->writes++;
+  uint64_t levels = sim_gpio_levels.load();
+  if (((levels & A_FWD) && (levels & A_REV)) || ((levels & B_FWD) && (levels & B_REV))) {
+    log->shoot_through++;
+  }
+}
+
+/**
+ * Motor pins as currently driven
+ */
+uint32_t motorPins() {
+  return (uint32_t)sim_gpio_levels.load() & MOTOR_PIN_MASK;
+}
+
+// Every command reaches the pins with one write, from every previous command
+void testApplyCommands() {
+  for (uint8_t from = 0; from < CONTROL_COMMAND_COUNT; from++) {
+    for (uint8_t to = 0; to < CONTROL_COMMAND_COUNT; to++) {
+      applyMotorCommand(&robot.motors, from, 200);
+      motor_log.writes = 0;
+      applyMotorCommand(&robot.motors, to, 100);
+      CHECK(motor_log.writes == 1);
+      CHECK(motorPins() == motor_table[to].set_mask);
+      CHECK(simPwmDuty(MOTOR_A_EN) == (motor_table[to].a_on ? 100U : 0U));
+      CHECK(simPwmDuty(MOTOR_B_EN) == (motor_table[to].b_on ? 100U : 0U));
+    }
+  }
+  CHECK(motor_log.shoot_through == 0);
+
+  // Unknown command on the wire or in the mailbox: stop
+  applyMotorCommand(&robot.motors, CONTROL_GO, 255);
+  applyMotorCommand(&robot.motors, CONTROL_COMMAND_COUNT, 255);
+  CHECK(motorPins() == 0 && simPwmDuty(MOTOR_A_EN) == 0 && simPwmDuty(MOTOR_B_EN) == 0);
+  applyMotorCommand(&robot.motors, CONTROL_GO, 255);
+  applyMotorCommand(&robot.motors, 0xFF, 255);
+  CHECK(motorPins() == 0);
+}
+
+// The enable PWM is only written when its duty changes
+void testRedundantDuty() {
+  applyMotorCommand(&robot.motors, CONTROL_GO, 180);
+  sim_pwm_duty[MOTOR_A_EN] = PWM_UNTOUCHED;
+  sim_pwm_duty[MOTOR_B_EN] = PWM_UNTOUCHED;
+  applyMotorCommand(&robot.motors, CONTROL_GO, 180);   // Same command, same speed
+  applyMotorCommand(&robot.motors, CONTROL_BACK, 180); // Direction change only
+  CHECK(simPwmDuty(MOTOR_A_EN) == PWM_UNTOUCHED && simPwmDuty(MOTOR_B_EN) == PWM_UNTOUCHED);
+  applyMotorCommand(&robot.motors, CONTROL_BACK, 90);
+  CHECK(simPwmDuty(MOTOR_A_EN) == 90 && simPwmDuty(MOTOR_B_EN) == 90);
+
+  // Re-init: halPwmAttach() leaves the enable pins at duty 0, the same command
+  // must write its duty again
+  motorInit(&robot.motors);
+  CHECK(simPwmDuty(MOTOR_A_EN) == 0 && simPwmDuty(MOTOR_B_EN) == 0);
+  applyMotorCommand(&robot.motors, CONTROL_BACK, 90);
+  CHECK(simPwmDuty(MOTOR_A_EN) == 90 && simPwmDuty(MOTOR_B_EN) == 90);
+  applyMotorCommand(&robot.motors, CONTROL_STOP, 0);
+}
+
+/**
+ * One control period on the simulated clock
+ */
+void controlPeriod() {
+  controlStep(&robot, &sonar);
+  simAdvance(CONTROL_PERIOD_MS * 1000);
+}
+
+// Only the latest post reaches the pins, with its own speed
+void testMailboxLatestWins() {
+  postCommand(&robot, CONTROL_LEFT, 40);
+  postCommand(&robot, CONTROL_GO, 120);
+  uint32_t samples = robot.command_latency_us.count.load();
+  controlPeriod();
+  CHECK(motorPins() == motor_table[CONTROL_GO].set_mask);
+  CHECK(simPwmDuty(MOTOR_A_EN) == 120 && simPwmDuty(MOTOR_B_EN) == 120);
+  CHECK(robot.command_latency_us.count.load() - samples == 1);
+
+  // Periods without a new post apply the same command and record nothing
+  controlPeriod();
+  controlPeriod();
+  CHECK(motorPins() == motor_table[CONTROL_GO].set_mask);
+  CHECK(robot.command_latency_us.count.load() - samples == 1);
+
+  postCommand(&robot, CONTROL_STOP, 0);
+  controlPeriod();
+  CHECK(motorPins() == 0);
+  CHECK(robot.command_latency_us.count.load() - samples == 2);
+}
+
+// A poster thread against the control task: command and speed always match
+void testMailboxConcurrent() {
+  postCommand(&robot, CONTROL_STOP, 50);
+  std::atomic<bool> running(true);
+  std::thread poster([&]() {
+    uint32_t n = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      uint8_t cmd = n % CONTROL_COMMAND_COUNT;
+      postCommand(&robot, cmd, 50 + cmd * 40);   // Speed tied to the command
+      n++;
+    }
+  });
+  uint32_t torn = 0;
+  for (int i = 0; i < 200000; i++) {
+    uint32_t posted = robot.mailbox.load(std::memory_order_acquire);
+    uint8_t cmd = posted & 0xFF;
+    if ((posted >> 8) != 50U + cmd * 40 || cmd >= CONTROL_COMMAND_COUNT) {
+      torn++;
+    }
+  }
+  running.store(false);
+  poster.join();
+  CHECK(torn == 0);
+  postCommand(&robot, CONTROL_STOP, 0);
+  controlPeriod();
+}
+
+/**
+ * Nanoseconds of the host's monotonic clock
+ */
+uint64_t monotonicNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Command-to-output cost on the host CPU
+ * @param rounds - Commands measured
+ * @param post_to_pins - Receives postCommand() + controlStep() times
+ * @param apply - Receives applyMotorCommand() times
+ */
+void benchCommandToOutput(int rounds, sim_stat_t *post_to_pins, sim_stat_t *apply) {
+  uint8_t cmd = CONTROL_STOP;
+  for (int i = 0; i < rounds; i++) {
+    cmd = (cmd + 1) % CONTROL_COMMAND_COUNT;
+    uint64_t start = monotonicNs();
+    postCommand(&robot, cmd, 255);
+    controlStep(&robot, &sonar);
+    uint64_t end = monotonicNs();
+    CHECK(motorPins() == motor_table[cmd].set_mask);
+    post_to_pins->values.push_back((double)(end - start));
+    simAdvance(CONTROL_PERIOD_MS * 1000);
+  }
+  for (int i = 0; i < rounds; i++) {
+    cmd = (cmd + 1) % CONTROL_COMMAND_COUNT;
+    uint64_t start = monotonicNs();
+    applyMotorCommand(&robot.motors, cmd, i & 0xFF);
+    apply->values.push_back((double)(monotonicNs() - start));
+  }
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  int rounds = 20000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+      rounds = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--rounds N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Same start-up as the robot's setup(), nothing in front of the sensor
+  motorInit(&robot.motors);
+  ultrasonicInit(&sonar, TRIG_PIN);
+  controlInit(&robot, BUZZER_PIN);
+  simSonarInit(&sim_sonar, &sonar, TRIG_PIN, 0);
+  simAddGpioHook(motorHook, &motor_log);
+
+  testApplyCommands();
+  testRedundantDuty();
+  testMailboxLatestWins();
+  testMailboxConcurrent();
+
+  sim_stat_t post_to_pins = { "command_to_pins_ns", "ns", {} };
+  sim_stat_t apply = { "apply_motor_command_ns", "ns", {} };
+  benchCommandToOutput(rounds, &post_to_pins, &apply);
+  simPrintHeader(csv);
+  simPrintStat(&post_to_pins, csv);
+  simPrintStat(&apply, csv);
+  CHECK(motor_log.shoot_through == 0);
+
+  return hostTestResult("test_motor");
+}
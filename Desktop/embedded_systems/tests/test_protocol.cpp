@@ -0,0 +1,346 @@
+/**
+ * Host test of robot_core/robot_protocol.h and the robot's UDP control channel
+ *
+ *   - CRC-8 against its check value, every single-bit error detected
+ *   - encode/decode round trip, rejected frames (length, magic, version, CRC,
+ *     unknown command)
+ *   - isNewerSequence() across the 16-bit wrap-around, acceptControlFrame()
+ *     dropping duplicated and reordered frames
+ *   - loopback benchmark of the two control paths of the IMU remote: one UDP
+ *     frame echoed by controlChannelLoop() against one HTTP GET on a new
+ *     connection (the web interface's /stop), printed as a table
+ *
+ * Usage: test_protocol [--csv] [--rounds N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <thread>
+
+// Pins of the ESP32 robot (Motor_Esp_32_Code.C)
+#define MOTOR_A_IN1 2
+#define MOTOR_A_IN2 12
+#define MOTOR_B_IN1 13
+#define MOTOR_B_IN2 15
+#define MOTOR_A_EN  26
+#define MOTOR_B_EN  27
+#define TRIG_PIN    14
+#define BUZZER_PIN  25
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/robot_control.h"
+#include "sim/sim_stats.h"
+#include "tests/host_test.h"
+
+#define REPLY_TIMEOUT_US  100000        // Same wait for the echo as the remote's benchmark
+
+robot_control_t robot;
+
+// ==== Codec ====
+
+/**
+ * Encode a frame into buf
+ */
+void encode(uint16_t seq, uint8_t command, uint8_t speed, uint8_t *buf) {
+  control_frame_t frame = { seq, command, speed };
+  CHECK(encodeControlFrame(&frame, buf) == CONTROL_FRAME_SIZE);
+}
+
+// CRC-8 with polynomial 0x07, initial value 0 (CRC-8/SMBUS)
+void testCrc() {
+  CHECK(controlCrc8((const uint8_t *)"123456789", 9) == 0xF4);  // Catalogued check value
+  CHECK(controlCrc8(NULL, 0) == 0);
+
+  uint8_t buf[CONTROL_FRAME_SIZE];
+  encode(0x1234, CONTROL_LEFT, 200, buf);
+  control_frame_t frame;
+  int detected = 0;
+  for (int bit = 0; bit < CONTROL_FRAME_SIZE * 8; bit++) {
+    buf[bit / 8] ^= 1 << (bit % 8);
+    detected += !decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame);
+    buf[bit / 8] ^= 1 << (bit % 8);
+  }
+  CHECK(detected == CONTROL_FRAME_SIZE * 8);
+}
+
+// Every field survives the round trip, little-endian sequence number
+void testRoundTrip() {
+  uint8_t buf[CONTROL_FRAME_SIZE];
+  for (uint8_t c = 0; c < CONTROL_COMMAND_COUNT; c++) {
+    encode(0xBEEF, c, 17 * c, buf);
+    CHECK(buf[0] == CONTROL_MAGIC && buf[1] == CONTROL_VERSION);
+    CHECK(buf[2] == 0xEF && buf[3] == 0xBE && buf[6] == 0);
+    control_frame_t frame = {};
+    CHECK(decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));
+    CHECK(frame.seq == 0xBEEF && frame.command == c && frame.speed == 17 * c);
+  }
+}
+
+/**
+ * Re-sign a frame after a field was changed, so only that field is wrong
+ */
+void resign(uint8_t *buf) {
+  buf[7] = controlCrc8(buf, CONTROL_FRAME_SIZE - 1);
+}
+
+// Well-formed CRC but not a frame of this protocol
+void testRejects() {
+  uint8_t buf[CONTROL_FRAME_SIZE * 2] = {};
+  control_frame_t frame;
+  encode(7, CONTROL_GO, 255, buf);
+  CHECK(decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE - 1, &frame));   // Truncated
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE + 1, &frame));   // Trailing bytes
+  CHECK(!decodeControlFrame(buf, 0, &frame));
+
+  buf[0] = CONTROL_MAGIC ^ 0xFF;
+  resign(buf);
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));       // Magic
+
+  encode(7, CONTROL_GO, 255, buf);
+  buf[1] = CONTROL_VERSION + 1;
+  resign(buf);
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));       // Newer protocol version
+
+  encode(7, CONTROL_GO, 255, buf);
+  buf[4] = CONTROL_COMMAND_COUNT;
+  resign(buf);
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));       // Unknown command
+  buf[4] = 0xFF;
+  resign(buf);
+  CHECK(!decodeControlFrame(buf, CONTROL_FRAME_SIZE, &frame));
+}
+
+// Sequence numbers compare modulo 2^16
+void testSequenceWrap() {
+  CHECK(isNewerSequence(1, 0));
+  CHECK(!isNewerSequence(0, 0));
+  CHECK(!isNewerSequence(0, 1));
+  CHECK(isNewerSequence(0, 0xFFFF));    // Wrap-around
+  CHECK(isNewerSequence(5, 0xFFFB));
+  CHECK(!isNewerSequence(0xFFFF, 0));   // Reordered across the wrap
+  CHECK(isNewerSequence(0x7FFF, 0));    // Half the sequence space ahead
+  CHECK(!isNewerSequence(0x8000, 0));   // Further ahead counts as old
+}
+
+// The robot follows the remote through the wrap and drops stale frames
+void testAcceptAcrossWrap() {
+  robot.udp_active.store(false);
+  uint32_t rejected = robot.udp_rejected.value.load();
+  control_frame_t frame = { 0xFFFE, CONTROL_GO, 100 };
+  CHECK(acceptControlFrame(&robot, &frame));
+  frame.seq = 0xFFFF;
+  CHECK(acceptControlFrame(&robot, &frame));
+  frame.seq = 0;
+  CHECK(acceptControlFrame(&robot, &frame));
+  frame.seq = 0;
+  frame.command = CONTROL_BACK;
+  CHECK(!acceptControlFrame(&robot, &frame));        // Duplicate
+  frame.seq = 0xFFFF;
+  CHECK(!acceptControlFrame(&robot, &frame));        // Late frame from before the wrap
+  CHECK((robot.mailbox.load() & 0xFF) == CONTROL_GO);
+  CHECK(robot.udp_rejected.value.load() - rejected == 2);
+
+  // After a link loss any sequence number is taken
+  releaseRemoteControl(&robot);
+  frame.seq = 0x9000;
+  CHECK(acceptControlFrame(&robot, &frame));
+  CHECK((robot.mailbox.load() & 0xFF) == CONTROL_BACK);
+}
+
+// ==== Loopback Benchmark ====
+
+/**
+ * Microseconds of the host's monotonic clock
+ */
+uint64_t monotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Port a socket is bound to
+ */
+uint16_t localPort(int sock) {
+  struct sockaddr_in addr = {};
+  socklen_t len = sizeof(addr);
+  getsockname(sock, (struct sockaddr *)&addr, &len);
+  return ntohs(addr.sin_port);
+}
+
+/**
+ * Stand-in for cmd_handler() of the robot's web server: one request per
+ * connection, parseCommandUri() + postCommand(), 200 or 404 (never returns)
+ * @param listener - Listening TCP socket
+ */
+void httpCommandServer(int listener) {
+  for (;;) {
+    int conn = accept(listener, NULL, NULL);
+    if (conn < 0) {
+      continue;
+    }
+    char request[512];
+    size_t len = 0;
+    while (len < sizeof(request) - 1) {
+      ssize_t n = recv(conn, request + len, sizeof(request) - 1 - len, 0);
+      if (n <= 0) {
+        break;
+      }
+      len += n;
+      request[len] = '\0';
+      if (strstr(request, "\r\n\r\n")) {
+        break;
+      }
+    }
+    request[len] = '\0';
+
+    char uri[64] = "";
+    uint8_t cmd;
+    sscanf(request, "GET %63s", uri);
+    const char *reply = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    if (parseCommandUri(uri, &cmd)) {
+      telemetryCount(&robot.http_commands);
+      postCommand(&robot, cmd, 255);
+      releaseRemoteControl(&robot);
+      reply = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=utf-8\r\n"
+              "Content-Length: 2\r\nConnection: close\r\n\r\nOK";
+    }
+    send(conn, reply, strlen(reply), MSG_NOSIGNAL);
+    close(conn);
+  }
+}
+
+/**
+ * One command over HTTP like the remote's HTTPClient: connect, GET, read the
+ * whole response, close
+ * @param port - Port of httpCommandServer()
+ * @param uri - Request URI
+ * @return HTTP status code, -1 if the request failed
+ */
+int httpGet(uint16_t port, const char *uri) {
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(sock);
+    return -1;
+  }
+  char request[128];
+  int len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n", uri);
+  send(sock, request, len, MSG_NOSIGNAL);
+
+  char response[256];
+  size_t received = 0;
+  ssize_t n;
+  while ((n = recv(sock, response + received, sizeof(response) - 1 - received, 0)) > 0) {
+    received += n;
+  }
+  response[received] = '\0';
+  close(sock);
+
+  int status = -1;
+  sscanf(response, "HTTP/1.1 %d", &status);
+  return status;
+}
+
+/**
+ * Send one frame and wait for its echo (sendControlFrame + pollControlEchoes)
+ * @param sock - Remote's UDP socket (receive timeout REPLY_TIMEOUT_US)
+ * @param robot_port - Port of controlChannelLoop()
+ * @param seq - Sequence number
+ * @return true if the echo of this frame came back
+ */
+bool udpRoundTrip(int sock, uint16_t robot_port, uint16_t seq) {
+  uint8_t buf[CONTROL_FRAME_SIZE * 2];
+  encode(seq, CONTROL_STOP, 0, buf);
+  hal_udp_peer_t robot_addr = { htonl(INADDR_LOOPBACK), robot_port };
+  halUdpSend(sock, buf, CONTROL_FRAME_SIZE, &robot_addr);
+
+  hal_udp_peer_t from;
+  int len = halUdpReceive(sock, buf, sizeof(buf), &from);
+  control_frame_t echo;
+  return len > 0 && decodeControlFrame(buf, len, &echo) && echo.seq == seq;
+}
+
+/**
+ * Command round trip on loopback: UDP frame -> echo against HTTP GET -> 200
+ * @param rounds - Commands per path
+ * @param udp_us - Receives the UDP round trips
+ * @param http_us - Receives the HTTP round trips (status 200 only)
+ */
+void benchControlPaths(int rounds, sim_stat_t *udp_us, sim_stat_t *http_us) {
+  // Robot side: the real UDP channel and the web server stand-in, on their own
+  // threads like the ESP32 tasks (blocked in recvfrom/accept until exit)
+  int robot_sock = halUdpOpen(0);
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bool listening = bind(listener, (struct sockaddr *)&addr, sizeof(addr)) == 0 && listen(listener, 8) == 0;
+  CHECK(robot_sock >= 0 && listening);
+  if (robot_sock < 0 || !listening) {
+    return;
+  }
+  std::thread(controlChannelLoop, &robot, robot_sock).detach();
+  std::thread(httpCommandServer, listener).detach();
+
+  int remote_sock = halUdpOpen(0);
+  struct timeval timeout = { 0, REPLY_TIMEOUT_US };
+  setsockopt(remote_sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  CHECK(httpGet(localPort(listener), "/nothing") == 404);   // Not counted as a delivered command
+  for (int i = 0; i < rounds; i++) {
+    uint64_t start = monotonicUs();
+    if (httpGet(localPort(listener), "/stop") == 200) {
+      http_us->values.push_back((double)(monotonicUs() - start));
+    }
+  }
+  for (int i = 0; i < rounds; i++) {
+    uint64_t start = monotonicUs();
+    if (udpRoundTrip(remote_sock, localPort(robot_sock), (uint16_t)(i + 1))) {
+      udp_us->values.push_back((double)(monotonicUs() - start));
+    }
+  }
+  close(remote_sock);
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  int rounds = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+      rounds = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--rounds N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  motorInit(&robot.motors);
+  controlInit(&robot, BUZZER_PIN);
+
+  testCrc();
+  testRoundTrip();
+  testRejects();
+  testSequenceWrap();
+  testAcceptAcrossWrap();
+
+  sim_stat_t udp_us = { "udp_command_rtt_us", "us", {} };
+  sim_stat_t http_us = { "http_command_rtt_us", "us", {} };
+  uint32_t http_commands = robot.http_commands.value.load();
+  benchControlPaths(rounds, &udp_us, &http_us);
+  simPrintHeader(csv);
+  simPrintStat(&udp_us, csv);
+  simPrintStat(&http_us, csv);
+  CHECK(udp_us.values.size() == (size_t)rounds);     // Every frame echoed
+  CHECK(http_us.values.size() == (size_t)rounds);
+  CHECK(robot.http_commands.value.load() - http_commands == (uint32_t)rounds);  // The 404 not counted
+
+  return hostTestResult("test_protocol");
+}
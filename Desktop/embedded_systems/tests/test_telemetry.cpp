@@ -0,0 +1,309 @@
+/**
+ * Host test of robot_core/telemetry.h: the /metrics text format, the binary
+ * dump and tools/decode_metrics.js
+ *
+ *   - Prometheus text: every family typed before its samples, cumulative
+ *     buckets ending in +Inf = _count, _sum of the observed values, the
+ *     maximum as its own gauge family
+ *   - binary dump: decoded field by field against the recorded values,
+ *     trace rings oldest sample first after a wrap
+ *   - a failing sink aborts the export
+ *   - the dump written to a file and decoded with node (when --node is given)
+ *
+ * Usage: test_telemetry [--node NODE --decoder tools/decode_metrics.js]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/telemetry.h"
+#include "tests/host_test.h"
+
+telemetry_counter_t frames;
+telemetry_counter_t free_heap;
+telemetry_hist_t latency_us;
+telemetry_hist_t empty_us;
+telemetry_ring_t ring;
+
+/**
+ * Sink collecting the output in a std::string
+ */
+bool stringSink(void *ctx, const void *data, size_t len) {
+  ((std::string *)ctx)->append((const char *)data, len);
+  return true;
+}
+
+/**
+ * Sink that accepts the first few writes, then fails (client went away)
+ */
+bool failingSink(void *ctx, const void *data, size_t len) {
+  (void)data;
+  (void)len;
+  int *left = (int *)ctx;
+  return (*left)-- > 0;
+}
+
+/**
+ * Register and fill the metrics: known counts, sum and maximum
+ * @return Sum of the values observed in latency_us
+ */
+uint64_t recordMetrics() {
+  simReset();
+  telemetryAddCounter(&frames, "frames_sent");
+  telemetryAddCounter(&free_heap, "free_heap", true);
+  telemetryAddHistogram(&empty_us, "empty_us");
+  telemetryAddHistogram(&latency_us, "command_latency_us");
+  telemetryAddRing(&ring, "control");
+
+  telemetryCount(&frames, 40);
+  telemetryCount(&frames);
+  telemetrySet(&free_heap, 123456);
+  uint64_t sum = 0;
+  for (uint32_t v : { 0u, 1u, 5u, 5u, 900u, 70000u, 4000000000u, 4000000000u }) {
+    telemetryObserve(&latency_us, v);
+    sum += v;
+  }
+  for (uint32_t i = 0; i < TELEMETRY_RING_SIZE + 72; i++) {
+    simAdvance(1000);
+    telemetryTrace(&ring, TRACE_DISTANCE_CM, i);
+  }
+  telemetryTrace(&ring, TRACE_FRAME_BYTES, 0x2000000);   // Saturates to 24 bits
+  simAdvance(500000);
+  return sum;
+}
+
+/**
+ * Samples of the text format by metric name (labels included)
+ */
+std::map<std::string, std::string> parseSamples(const std::string &text, std::vector<std::string> *order) {
+  std::map<std::string, std::string> samples;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    std::string line = text.substr(pos, end - pos);
+    pos = end + 1;
+    order->push_back(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    size_t space = line.rfind(' ');
+    samples[line.substr(0, space)] = line.substr(space + 1);
+  }
+  return samples;
+}
+
+/**
+ * Index of a line in the output, -1 if missing
+ */
+int lineIndex(const std::vector<std::string> &lines, const std::string &line) {
+  for (size_t i = 0; i < lines.size(); i++) {
+    if (lines[i] == line) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+void testText(uint64_t sum) {
+  std::string text;
+  CHECK(writeMetricsText(stringSink, &text));
+  CHECK(!text.empty() && text.back() == '\n');
+  std::vector<std::string> lines;
+  std::map<std::string, std::string> s = parseSamples(text, &lines);
+
+  // Every family typed, TYPE line before its first sample
+  CHECK(lineIndex(lines, "# TYPE uptime_ms gauge") == 0 && s["uptime_ms"] == "1700");
+  CHECK(lineIndex(lines, "# TYPE frames_sent counter") >= 0 && s["frames_sent"] == "41");
+  CHECK(lineIndex(lines, "# TYPE free_heap gauge") >= 0 && s["free_heap"] == "123456");
+  int hist_type = lineIndex(lines, "# TYPE command_latency_us histogram");
+  CHECK(hist_type >= 0 && hist_type < lineIndex(lines, "command_latency_us_bucket{le=\"0\"} 1"));
+
+  // Cumulative buckets, +Inf = _count, _sum of the values
+  CHECK(s["command_latency_us_bucket{le=\"1\"}"] == "2");
+  CHECK(s["command_latency_us_bucket{le=\"7\"}"] == "4");
+  CHECK(s["command_latency_us_bucket{le=\"1023\"}"] == "5");
+  CHECK(s["command_latency_us_bucket{le=\"131071\"}"] == "6");
+  CHECK(s["command_latency_us_bucket{le=\"+Inf\"}"] == "8");
+  CHECK(s["command_latency_us_count"] == "8");
+  CHECK(s["command_latency_us_sum"] == std::to_string(sum));  // Above 2^32
+  CHECK(sum > UINT32_MAX);
+
+  // Maximum: its own gauge family after the histogram, not a histogram sample
+  int max_type = lineIndex(lines, "# TYPE command_latency_us_max gauge");
+  CHECK(max_type > lineIndex(lines, "command_latency_us_count 8"));
+  CHECK(s["command_latency_us_max"] == "4000000000");
+
+  // A histogram nothing was observed in
+  CHECK(s["empty_us_bucket{le=\"+Inf\"}"] == "0" && s["empty_us_sum"] == "0" && s["empty_us_count"] == "0");
+  CHECK(s.count("empty_us_bucket{le=\"0\"}") == 0);
+  CHECK(s["empty_us_max"] == "0");
+}
+
+// Little-endian reader over the dump
+typedef struct {
+  const std::string *buf;
+  size_t pos;
+  bool overrun;                         // Read past the end
+} dump_reader_t;
+
+uint32_t getU32(dump_reader_t *r) {
+  if (r->pos + 4 > r->buf->size()) {
+    r->overrun = true;
+    return 0;
+  }
+  const uint8_t *p = (const uint8_t *)r->buf->data() + r->pos;
+  r->pos += 4;
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+std::string getName(dump_reader_t *r) {
+  if (r->pos + TELEMETRY_NAME_LEN > r->buf->size()) {
+    r->overrun = true;
+    return "";
+  }
+  std::string name(r->buf->data() + r->pos, strnlen(r->buf->data() + r->pos, TELEMETRY_NAME_LEN));
+  r->pos += TELEMETRY_NAME_LEN;
+  return name;
+}
+
+void testBinary(uint64_t sum, std::string *dump) {
+  static trace_entry_t scratch[TELEMETRY_RING_SIZE];
+  CHECK(writeMetricsBinary(stringSink, dump, scratch));
+  dump_reader_t r = { dump, 0, false };
+
+  CHECK(getU32(&r) == TELEMETRY_MAGIC);
+  CHECK(memcmp(dump->data(), "RTM2", 4) == 0);
+  CHECK(getU32(&r) == 1700);            // uptime_ms
+  CHECK(getU32(&r) == 2);               // Counters
+  CHECK(getU32(&r) == 2);               // Histograms
+  CHECK(getU32(&r) == 1);               // Rings
+  CHECK(getU32(&r) == TELEMETRY_HIST_BUCKETS);
+
+  // Newest registration first
+  CHECK(getName(&r) == "free_heap" && getU32(&r) == 1 && getU32(&r) == 123456);
+  CHECK(getName(&r) == "frames_sent" && getU32(&r) == 0 && getU32(&r) == 41);
+
+  CHECK(getName(&r) == "command_latency_us");
+  CHECK(getU32(&r) == 8);
+  CHECK(getU32(&r) == 4000000000u);
+  uint32_t sum_low = getU32(&r);
+  uint32_t sum_high = getU32(&r);
+  CHECK(((uint64_t)sum_high << 32 | sum_low) == sum);
+  uint32_t bucket_total = 0;
+  for (int i = 0; i < TELEMETRY_HIST_BUCKETS; i++) {
+    uint32_t n = getU32(&r);
+    bucket_total += n;
+    if (i == telemetryBucket(5)) {
+      CHECK(n == 2);
+    }
+  }
+  CHECK(bucket_total == 8);
+
+  CHECK(getName(&r) == "empty_us" && getU32(&r) == 0 && getU32(&r) == 0 && getU32(&r) == 0 && getU32(&r) == 0);
+  r.pos += TELEMETRY_HIST_BUCKETS * 4;
+
+  // Ring: oldest sample first; of a full ring the slot the writer would fill
+  // next is left out (see snapshotTraceRing())
+  uint32_t written = TELEMETRY_RING_SIZE + 73;
+  uint32_t first_seq = written - TELEMETRY_RING_SIZE + 1;
+  CHECK(getName(&r) == "control");
+  CHECK(getU32(&r) == first_seq);
+  CHECK(getU32(&r) == TELEMETRY_RING_SIZE - 1);
+  uint32_t last_time = 0;
+  bool ordered = true;
+  for (uint32_t i = 0; i < TELEMETRY_RING_SIZE - 1; i++) {
+    uint32_t time_us = getU32(&r);
+    uint32_t word = getU32(&r);
+    ordered &= time_us >= last_time;
+    last_time = time_us;
+    if (i == 0) {
+      CHECK(word == ((uint32_t)TRACE_DISTANCE_CM << 24 | first_seq));
+    }
+    if (i == TELEMETRY_RING_SIZE - 2) {
+      CHECK(word == ((uint32_t)TRACE_FRAME_BYTES << 24 | 0xFFFFFF));
+    }
+  }
+  CHECK(ordered);
+  CHECK(!r.overrun && r.pos == dump->size());
+}
+
+// The client going away stops the export
+void testFailingSink() {
+  static trace_entry_t scratch[TELEMETRY_RING_SIZE];
+  int left = 1;
+  CHECK(!writeMetricsBinary(failingSink, &left, scratch));
+  CHECK(left == -1);                    // One failed write, nothing after it
+  left = 0;
+  CHECK(!writeMetricsText(failingSink, &left));
+}
+
+/**
+ * Decode the dump with tools/decode_metrics.js
+ * @param node - node executable
+ * @param decoder - decode_metrics.js
+ * @param dump - Binary dump
+ */
+void testDecoder(const char *node, const char *decoder, const std::string &dump) {
+  char path[] = "/tmp/test_telemetry_XXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd >= 0);
+  if (fd < 0) {
+    return;
+  }
+  CHECK(write(fd, dump.data(), dump.size()) == (ssize_t)dump.size());
+  close(fd);
+
+  std::string command = std::string("\"") + node + "\" \"" + decoder + "\" " + path + " 2>&1";
+  FILE *p = popen(command.c_str(), "r");
+  std::string output;
+  char buf[256];
+  while (p && fgets(buf, sizeof(buf), p)) {
+    output += buf;
+  }
+  int status = p ? pclose(p) : -1;
+  unlink(path);
+  printf("%s", output.c_str());
+
+  CHECK(status == 0);
+  CHECK(output.find("Uptime: 1.7 s") != std::string::npos);
+  CHECK(output.find("frames_sent") != std::string::npos && output.find("123456  (gauge)") != std::string::npos);
+
+  // count 8, mean of the observed values
+  char row[128];
+  snprintf(row, sizeof(row), "%11d%11lld", 8, (long long)((8000000000LL + 70911) / 8.0 + 0.5));
+  CHECK(output.find(std::string("command_latency_us    ") + row) != std::string::npos);
+  CHECK(output.find("control: 127 samples") != std::string::npos);
+  CHECK(output.find("frame_bytes") != std::string::npos);
+}
+
+int main(int argc, char **argv) {
+  const char *node = NULL;
+  const char *decoder = "tools/decode_metrics.js";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--node") == 0 && i + 1 < argc) {
+      node = argv[++i];
+    } else if (strcmp(argv[i], "--decoder") == 0 && i + 1 < argc) {
+      decoder = argv[++i];
+    } else {
+      fprintf(stderr, "Usage: %s [--node NODE --decoder tools/decode_metrics.js]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  uint64_t sum = recordMetrics();
+  testText(sum);
+  std::string dump;
+  testBinary(sum, &dump);
+  testFailingSink();
+  if (node) {
+    testDecoder(node, decoder, dump);
+  } else {
+    printf("node not given, tools/decode_metrics.js not checked\n");
+  }
+
+  return hostTestResult("test_telemetry");
+}
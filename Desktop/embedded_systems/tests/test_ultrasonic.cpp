@@ -0,0 +1,255 @@
+/**
+ * Host test of robot_core/ultrasonic.h with the simulated HC-SR04
+ *
+ * Runs the control task on the simulated clock against sim/sim_sonar.h:
+ *   - a ping is re-armed once its echo is over: never while ECHO is high or
+ *     within PING_RECOVERY_US of its end, a near target once per control period
+ *   - a lost ping is counted once, also when ECHO is still high at the timeout
+ *   - an echo that started before the current ping, or ended after it was
+ *     counted as lost, is discarded
+ *   - a single bad echo does not start the emergency reverse
+ *   - obstacle-to-stop latency: obstacle appears -> reverse on the motor pins
+ *     (printed as a table, checked against a fixed bound well below the
+ *     ~150 ms of the old pulseIn() loop)
+ *
+ * Usage: test_ultrasonic [--csv] [--trials N]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+
+// Pins of the ESP32 robot (Motor_Esp_32_Code.C)
+#define MOTOR_A_IN1 2
+#define MOTOR_A_IN2 12
+#define MOTOR_B_IN1 13
+#define MOTOR_B_IN2 15
+#define MOTOR_A_EN  26
+#define MOTOR_B_EN  27
+#define TRIG_PIN    14
+#define BUZZER_PIN  25
+
+#include "robot_core/robot_hal_linux.h"
+#include "robot_core/robot_control.h"
+#include "sim/sim_sonar.h"
+#include "sim/sim_stats.h"
+#include "tests/host_test.h"
+
+// Obstacle -> reverse must stay well below the ~150 ms worst case of the old
+// loop (pulseIn() up to 30 ms + delay(120))
+#define MAX_REACTION_US  100000
+
+// Trigger times seen on the trigger pin
+typedef struct {
+  uint64_t last_us;                     // Previous trigger (falling edge), 0 = none yet
+  uint64_t min_gap_us;                  // Shortest time between two triggers
+  uint32_t count;                       // Triggers
+  uint32_t early;                       // Triggers while ECHO was high or had just dropped
+} trigger_log_t;
+
+robot_control_t robot;
+ultrasonic_t sonar;
+sim_sonar_t sim_sonar;
+trigger_log_t triggers;
+
+/**
+ * GPIO hook: record trigger pulses (falling edge)
+ */
+void triggerHook(void *ctx, uint64_t clear_mask, uint64_t set_mask) {
+  trigger_log_t *log = (trigger_log_t *)ctx;
+  (void)set_mask;
+  if (!(clear_mask & (1ULL << TRIG_PIN))) {
+    return;
+  }
+  uint64_t now = simNow();
+  if (log->last_us && now - log->last_us < log->min_gap_us) {
+    log->min_gap_us = now - log->last_us;
+  }
+  log->last_us = now;
+  log->count++;
+  if (sonar.echo_high || halMicros() - sonar.echo_end_us < PING_RECOVERY_US) {
+    log->early++;
+  }
+}
+
+/**
+ * Start a test case: fresh simulator, sensor, simulated HC-SR04 and trigger log
+ * @param distance_cm - Target distance, 0 = nothing in range
+ */
+void startCase(float distance_cm) {
+  simReset();
+  ultrasonicInit(&sonar, TRIG_PIN);
+  simSonarInit(&sim_sonar, &sonar, TRIG_PIN, distance_cm);
+  triggers = { 0, UINT64_MAX, 0, 0 };
+  simAddGpioHook(triggerHook, &triggers);
+  robot.last_step_us = 0;
+  robot.obstacle = false;
+}
+
+/**
+ * Run control periods, counting the readings the sensor produced
+ * @param periods - Control periods
+ * @return Readings (echoes and lost pings)
+ */
+uint32_t runPeriods(int periods) {
+  uint32_t readings = 0;
+  for (int p = 0; p < periods; p++) {
+    uint32_t last_sample_us = sonar.sample_us;
+    controlStep(&robot, &sonar);
+    if (sonar.sample_us != last_sample_us) {
+      readings++;
+    }
+    simAdvance(CONTROL_PERIOD_MS * 1000);
+  }
+  return readings;
+}
+
+// A target in range is pinged every control period, one reading per ping
+void testPingInterval() {
+  startCase(100);
+  uint32_t readings = runPeriods(100);   // 2 s
+  CHECK(triggers.min_gap_us >= CONTROL_PERIOD_MS * 1000);
+  CHECK(triggers.count >= 99 && triggers.count <= 100);
+  CHECK(triggers.early == 0);
+  CHECK(sim_sonar.ignored == 0);
+  CHECK(readings == triggers.count || readings + 1 == triggers.count);  // Last ping may be in flight
+  CHECK(sonar.distance_cm >= 97 && sonar.distance_cm <= 100);
+}
+
+// Nothing in range, ECHO held past the timeout: each lost ping counts once
+void testLostPing(uint32_t hold_us) {
+  startCase(0);
+  sim_sonar.hold_us = hold_us;
+  uint32_t readings = runPeriods(150);   // 3 s
+  printf("lost pings, ECHO held %u ms: %u triggers, %u readings, %u ignored by the module\n",
+         (unsigned)(hold_us / 1000), (unsigned)triggers.count, (unsigned)readings, (unsigned)sim_sonar.ignored);
+  CHECK(sim_sonar.ignored == 0);        // Never triggered while ECHO was high
+  CHECK(triggers.early == 0);
+  CHECK(readings == triggers.count || readings + 1 == triggers.count);
+  CHECK(triggers.min_gap_us >= hold_us);
+  CHECK(sonar.distance_cm == MAX_DISTANCE_CM);
+}
+// Echo edges that rose before the current trigger or ended after it was counted as lost
+// Echo edges that rose before the current trigger
+void testStaleEcho() {
+  startCase(0);
+  sim_sonar.hold_us = 45000;
+  runPeriods(1);                        // First ping
+  CHECK(sonar.ping_active);
+  uint32_t ping_us = sonar.ping_start_us;
+
+  // Echo that rose before this ping (from an earlier, lost one)
+  ultrasonicEchoEdge(&sonar, true, ping_us - 100);
+  ultrasonicEchoEdge(&sonar, false, ping_us + 200);
+  uint32_t sample_us = sonar.sample_us;
+  ultrasonicPoll(&sonar);
+  CHECK(sonar.sample_us == sample_us);  // Not taken as a reading
+  CHECK(sonar.ping_active);             // Still waiting for this ping's echo
+
+  // Late end of a lost ping: ECHO held 45 ms, the ping times out at 30 ms
+  startCase(0);
+  sim_sonar.hold_us = 45000;
+  runPeriods(1);
+  ping_us = sonar.ping_start_us;
+  simAdvance(ping_us + ECHO_TIMEOUT_US + 1000 - halMicros());
+  ultrasonicPoll(&sonar);               // Lost ping counted
+  CHECK(!sonar.ping_active && sonar.echo_high);   // Not re-armed while ECHO is high
+  sample_us = sonar.sample_us;
+  long distance = sonar.distance_cm;
+
+  // The echo ends while no ping is waiting: dropped, next ping after the recovery guard
+  uint32_t echo_end_us = ping_us + SIM_SONAR_BURST_US + sim_sonar.hold_us;
+  simAdvance(echo_end_us + PING_RECOVERY_US / 2 - halMicros());
+  ultrasonicPoll(&sonar);
+  CHECK(sonar.sample_us == sample_us && sonar.distance_cm == distance);
+  CHECK(!sonar.ping_active);
+  simAdvance(PING_RECOVERY_US);
+  ultrasonicPoll(&sonar);
+  CHECK(sonar.ping_active && sonar.sample_us == sample_us);
+}
+
+// One echo from something passing close by is filtered out
+void testSingleBadEcho() {
+  startCase(0);
+  runPeriods(20);
+  sim_sonar.distance_cm = 3;
+  uint32_t pings = sim_sonar.pings;
+  while (sim_sonar.pings == pings) {
+    runPeriods(1);
+  }
+  sim_sonar.distance_cm = 0;
+  bool reversed = false;
+  for (int p = 0; p < 20; p++) {
+    runPeriods(1);
+    reversed |= robot.obstacle;
+  }
+  CHECK(!reversed);
+}
+
+/**
+ * Obstacle-to-stop latency: the robot drives forward, an obstacle appears at a
+ * random time, measured until the reverse pattern is on the motor pins
+ * @param trials - Number of obstacles
+ * @param latency - Receives the latencies in microseconds
+ */
+void measureObstacleToStop(int trials, sim_stat_t *latency) {
+  std::mt19937 rng(2);
+  startCase(0);
+  postCommand(&robot, CONTROL_GO, 255);
+
+  for (int i = 0; i < trials; i++) {
+    // Clear path until the median filter has forgotten the last obstacle
+    sim_sonar.distance_cm = 0;
+    runPeriods(15 + rng() % 5);
+
+    // Obstacle at 3 cm, appearing somewhere inside a control period
+    controlStep(&robot, &sonar);
+    uint32_t offset = rng() % (CONTROL_PERIOD_MS * 1000);
+    simAdvance(offset);
+    sim_sonar.distance_cm = 3;
+    uint64_t appeared_us = simNow();
+    simAdvance(CONTROL_PERIOD_MS * 1000 - offset);
+    for (int p = 0; p < 50; p++) {
+      controlStep(&robot, &sonar);
+      uint32_t pins = (uint32_t)sim_gpio_levels.load() & MOTOR_PIN_MASK;
+      if (robot.obstacle && pins == motor_table[CONTROL_BACK].set_mask) {
+        latency->values.push_back((double)(simNow() - appeared_us));
+        break;
+      }
+      simAdvance(CONTROL_PERIOD_MS * 1000);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  int trials = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+      trials = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [--trials N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  motorInit(&robot.motors);
+  controlInit(&robot, BUZZER_PIN);
+
+  testPingInterval();
+  testLostPing(SIM_SONAR_NO_ECHO_US);
+  testLostPing(200000);                 // Clone holding ECHO for 200 ms
+  testStaleEcho();
+  testSingleBadEcho();
+
+  sim_stat_t latency = { "obstacle_to_stop_us", "us", {} };
+  measureObstacleToStop(trials, &latency);
+  simPrintHeader(csv);
+  simPrintStat(&latency, csv);
+  CHECK(latency.values.size() == (size_t)trials);  // Every obstacle answered
+  CHECK(!latency.values.empty() && latency.values.back() <= MAX_REACTION_US);
+
+  return hostTestResult("test_ultrasonic");
+}
@@ -0,0 +1,233 @@
+/**
+ * Host test of the precompressed web pages (robot_core/web_asset.h,
+ * web_asset_esp32.h and the generated web_assets.h)
+ *
+ * sendWebAsset() runs unchanged against tests/stubs/esp_http_server.h, behind
+ * a loopback HTTP server, and a client checks what a browser would receive:
+ *   - first load: 200 with Content-Encoding: gzip, ETag, Cache-Control:
+ *     no-cache, Content-Length and the gzip bytes of the page
+ *   - revalidation with the ETag (also weak, in a list, "*"): 304 with the
+ *     same ETag and an empty body
+ *   - a stale ETag gets the full page again
+ *   - etagMatches() on its own
+ *
+ * Usage: test_web_asset
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "robot_core/web_asset_esp32.h"
+#include "robot_core/web_assets.h"
+#include "tests/host_test.h"
+
+// Response as the browser parses it
+typedef struct {
+  int status;                           // Status code, -1 = no response
+  std::string headers;                  // Header block (without the status line)
+  std::string body;
+} http_response_t;
+
+/**
+ * Route of the stand-in server: the index pages of both robots
+ */
+const web_asset_t *assetFor(const char *uri) {
+  if (strcmp(uri, "/") == 0) {
+    return &web_index_robot;
+  }
+  if (strcmp(uri, "/camera") == 0) {
+    return &web_index_camera;
+  }
+  if (strcmp(uri, "/camera_missing") == 0) {
+    return &web_index_camera_missing;
+  }
+  return NULL;
+}
+
+/**
+ * Loopback HTTP server: one request per connection, handed to sendWebAsset()
+ * (never returns)
+ * @param listener - Listening TCP socket
+ */
+void webServer(int listener) {
+  for (;;) {
+    int conn = accept(listener, NULL, NULL);
+    if (conn < 0) {
+      continue;
+    }
+    std::string request;
+    char buf[512];
+    ssize_t n;
+    while (request.find("\r\n\r\n") == std::string::npos && (n = recv(conn, buf, sizeof(buf), 0)) > 0) {
+      request.append(buf, n);
+    }
+
+    char uri[256] = "";
+    sscanf(request.c_str(), "GET %255s", uri);
+    size_t headers_start = request.find("\r\n") + 2;
+    size_t headers_end = request.find("\r\n\r\n") + 2;
+    static httpd_req_t req;
+    httpdReqInit(&req, uri, request.substr(headers_start, headers_end - headers_start).c_str());
+    const web_asset_t *asset = assetFor(uri);
+    if (asset) {
+      sendWebAsset(&req, asset);
+    } else {
+      httpd_resp_set_status(&req, "404 Not Found");
+      httpd_resp_send(&req, NULL, 0);
+    }
+    send(conn, req.response.data(), req.response.size(), MSG_NOSIGNAL);
+    close(conn);
+  }
+}
+
+/**
+ * GET a page from the server
+ * @param port - Server port
+ * @param uri - Request URI
+ * @param extra_headers - Additional request header lines ("" = none)
+ * @return Parsed response
+ */
+http_response_t httpGet(uint16_t port, const char *uri, const char *extra_headers) {
+  http_response_t response = { -1, "", "" };
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(sock);
+    return response;
+  }
+  std::string request = std::string("GET ") + uri + " HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                        "Accept-Encoding: gzip, deflate\r\n" + extra_headers + "Connection: close\r\n\r\n";
+  send(sock, request.data(), request.size(), MSG_NOSIGNAL);
+
+  std::string raw;
+  char buf[1024];
+  ssize_t n;
+  while ((n = recv(sock, buf, sizeof(buf), 0)) > 0) {
+    raw.append(buf, n);
+  }
+  close(sock);
+
+  size_t status_end = raw.find("\r\n");
+  size_t headers_end = raw.find("\r\n\r\n");
+  if (status_end == std::string::npos || headers_end == std::string::npos) {
+    return response;
+  }
+  sscanf(raw.c_str(), "HTTP/1.1 %d", &response.status);
+  response.headers = raw.substr(status_end + 2, headers_end + 2 - (status_end + 2));
+  response.body = raw.substr(headers_end + 4);
+  return response;
+}
+
+/**
+ * Value of a response header, "" if missing
+ */
+std::string header(const http_response_t &response, const char *field) {
+  std::string needle = std::string(field) + ": ";
+  size_t pos = response.headers.find(needle);
+  if (pos == std::string::npos || (pos != 0 && response.headers[pos - 1] != '\n')) {
+    return "";
+  }
+  size_t start = pos + needle.size();
+  return response.headers.substr(start, response.headers.find("\r\n", start) - start);
+}
+
+/**
+ * Uncompressed size stored in the gzip trailer (ISIZE, little endian)
+ */
+uint32_t gzipSize(const std::string &gz) {
+  const uint8_t *end = (const uint8_t *)gz.data() + gz.size();
+  return end[-4] | (end[-3] << 8) | (end[-2] << 16) | ((uint32_t)end[-1] << 24);
+}
+
+// First visit: the whole gzip page with its caching headers
+void testFirstLoad(uint16_t port, const char *uri, const web_asset_t *asset, uint32_t html_bytes) {
+  http_response_t r = httpGet(port, uri, "");
+  CHECK(r.status == 200);
+  CHECK(header(r, "Content-Type") == asset->content_type);
+  CHECK(header(r, "Content-Encoding") == "gzip");
+  CHECK(header(r, "ETag") == asset->etag);
+  CHECK(header(r, "Cache-Control") == "no-cache");
+  CHECK(header(r, "Content-Length") == std::to_string(asset->len));
+  CHECK(r.body.size() == asset->len && memcmp(r.body.data(), asset->data, asset->len) == 0);
+  CHECK(r.body.size() > 18 && (uint8_t)r.body[0] == 0x1f && (uint8_t)r.body[1] == 0x8b && r.body[2] == 8);
+  CHECK(r.body.size() > 18 && gzipSize(r.body) == html_bytes);
+  printf("%-16s 200: %zu body bytes (%u uncompressed), %zu header bytes\n", uri, r.body.size(),
+         (unsigned)html_bytes, r.headers.size());
+}
+
+// Revalidation: 304 without a body
+void testRevalidate(uint16_t port, const char *uri, const web_asset_t *asset) {
+  std::string etag = asset->etag;
+  const std::string conditions[] = {
+    "If-None-Match: " + etag + "\r\n",
+    "If-None-Match: W/" + etag + "\r\n",                      // Weak form
+    "If-None-Match: \"0000\", " + etag + "\r\n",              // In a list
+    "if-none-match: " + etag + "\r\n",                        // Field names are case-insensitive
+    "If-None-Match: *\r\n",
+  };
+  for (const std::string &condition : conditions) {
+    http_response_t r = httpGet(port, uri, condition.c_str());
+    CHECK(r.status == 304);
+    CHECK(r.body.empty());
+    CHECK(header(r, "Content-Length") == "0");
+    CHECK(header(r, "ETag") == asset->etag);
+    CHECK(header(r, "Cache-Control") == "no-cache");
+    CHECK(header(r, "Content-Encoding") == "");               // No gzip body to decode
+  }
+
+  // A page from an older firmware: the current one comes back
+  http_response_t r = httpGet(port, uri, "If-None-Match: \"0123456789abcdef\"\r\n");
+  CHECK(r.status == 200 && r.body.size() == asset->len);
+  CHECK(header(r, "ETag") == asset->etag);
+}
+
+// Header parsing without the server
+void testEtagMatches() {
+  CHECK(etagMatches("\"abc\"", "\"abc\""));
+  CHECK(etagMatches("W/\"abc\"", "\"abc\""));
+  CHECK(etagMatches("\"x\", W/\"abc\" ", "\"abc\""));
+  CHECK(etagMatches("*", "\"abc\""));
+  CHECK(!etagMatches("", "\"abc\""));
+  CHECK(!etagMatches("\"abcd\"", "\"abc\""));
+  CHECK(!etagMatches("\"ab\"", "\"abc\""));
+  CHECK(!etagMatches("abc", "\"abc\""));                     // Quotes are part of the tag
+}
+
+int main() {
+  testEtagMatches();
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  bool listening = bind(listener, (struct sockaddr *)&addr, sizeof(addr)) == 0 && listen(listener, 8) == 0 &&
+                   getsockname(listener, (struct sockaddr *)&addr, &len) == 0;
+  CHECK(listening);
+  if (!listening) {
+    return hostTestResult("test_web_asset");
+  }
+  uint16_t port = ntohs(addr.sin_port);
+  std::thread(webServer, listener).detach();   // Blocked in accept() until exit
+
+  // Uncompressed sizes as listed in web_assets.h
+  testFirstLoad(port, "/", &web_index_robot, 1902);
+  testFirstLoad(port, "/camera", &web_index_camera, 2182);
+  testFirstLoad(port, "/camera_missing", &web_index_camera_missing, 2066);
+  testRevalidate(port, "/", &web_index_robot);
+  testRevalidate(port, "/camera", &web_index_camera);
+  CHECK(strcmp(web_index_robot.etag, web_index_camera.etag) != 0);
+  CHECK(strcmp(web_index_camera.etag, web_index_camera_missing.etag) != 0);
+  CHECK(httpGet(port, "/missing", "").status == 404);
+
+  return hostTestResult("test_web_asset");
+}
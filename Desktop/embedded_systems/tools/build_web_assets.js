@@ -0,0 +1,129 @@
+// Builds robot_core/web_assets.h from the pages in web/
+//
+// Each page variant is filled in from web/index.html, minified, gzipped and
+// written as a constexpr byte array together with a strong ETag (hash of the
+// compressed bytes), so the robots serve it straight from flash.
+//
+// Usage: node tools/build_web_assets.js           (re-run after editing web/)
+//        node tools/build_web_assets.js --check   (fail if the committed header is stale)
+//
+// --check compares the pages after gunzip and the ETags against the committed
+// bytes, so a different zlib build compressing differently is not a failure.
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const crypto = require('crypto');
+
+const rootDir = path.join(__dirname, '..');
+const webDir = path.join(rootDir, 'web');
+const outFile = path.join(rootDir, 'robot_core', 'web_assets.h');
+
+// Page variants: C name, template values
+const variants = [
+  {
+    name: 'web_index_robot',
+    comment: 'Control page of the ESP32 robot without camera',
+    values: { TITLE: 'ESP32 Robot Control', HEADING: 'ESP32 Robot', CAMERA: '' },
+  },
+  {
+    name: 'web_index_camera',
+    comment: 'Control page of the ESP32-CAM robot with the live stream',
+    values: { TITLE: 'ESP32-CAM Robot Control', HEADING: 'ESP32-CAM Robot', CAMERA: readWeb('camera_stream.html') },
+  },
+  {
+    name: 'web_index_camera_missing',
+    comment: 'Control page of the ESP32-CAM robot when the camera failed',
+    values: { TITLE: 'ESP32-CAM Robot Control', HEADING: 'ESP32-CAM Robot', CAMERA: readWeb('camera_missing.html') },
+  },
+];
+
+function readWeb(file) {
+  return fs.readFileSync(path.join(webDir, file), 'utf8');
+}
+
+// Whitespace and comment removal for the hand-written pages in web/
+// (every JS statement ends with ';', '{' or '}', so lines can be joined)
+function minify(html) {
+  return html
+    .replace(/<!--[\s\S]*?-->/g, '')
+    .replace(/\/\*[\s\S]*?\*\//g, '')
+    .split('\n')
+    .map((line) => line.trim())
+    .filter((line) => line !== '' && !line.startsWith('//'))
+    .join('');
+}
+
+function byteArray(bytes) {
+  const lines = [];
+  for (let i = 0; i < bytes.length; i += 16) {
+    const row = Array.from(bytes.subarray(i, i + 16), (b) => '0x' + b.toString(16).padStart(2, '0'));
+    lines.push('  ' + row.join(', ') + ',');
+  }
+  return lines.join('\n');
+}
+
+// Minify first so placeholders mentioned in comments are not filled in
+const page = minify(readWeb('index.html'));
+const pages = variants.map((variant) => page.replace(/{{(\w+)}}/g, (match, key) => minify(variant.values[key])));
+
+// Compare the committed header with web/ and exit
+function checkHeader() {
+  const header = fs.readFileSync(outFile, 'utf8');
+  let stale = 0;
+  variants.forEach((variant, i) => {
+    const array = header.match(new RegExp('constexpr uint8_t ' + variant.name + '_gz\\[\\] = \\{([^}]*)\\};'));
+    const etag = header.match(new RegExp('constexpr web_asset_t ' + variant.name + ' = \\{[^}]*"(\\\\"\\w+\\\\")"'));
+    if (!array || !etag) {
+      console.error(variant.name + ': missing');
+      stale++;
+      return;
+    }
+    const gz = Buffer.from(array[1].match(/0x[0-9a-f]{2}/g).map((b) => parseInt(b, 16)));
+    if (zlib.gunzipSync(gz).toString('utf8') !== pages[i]) {
+      console.error(variant.name + ': differs from web/');
+      stale++;
+    } else if (JSON.parse('"' + etag[1] + '"') !== '"' + crypto.createHash('sha256').update(gz).digest('hex').slice(0, 16) + '"') {
+      console.error(variant.name + ': ETag does not match its bytes');
+      stale++;
+    }
+  });
+  if (stale) {
+    console.error(path.relative(rootDir, outFile) + ' is stale - run node tools/build_web_assets.js');
+    process.exit(1);
+  }
+  console.log(path.relative(rootDir, outFile) + ' matches web/ (' + variants.length + ' pages)');
+}
+
+if (process.argv[2] === '--check') {
+  checkHeader();
+  process.exit(0);
+}
+
+let out = '';
+out += '/**\n';
+out += ' * Precompressed web pages (generated by tools/build_web_assets.js from web/)\n';
+out += ' * Do not edit by hand - change web/ and re-run the script.\n';
+out += ' */\n';
+out += '#pragma once\n\n';
+out += '#include "web_asset.h"\n';
+
+variants.forEach((variant, i) => {
+  const html = pages[i];
+  const gz = zlib.gzipSync(Buffer.from(html, 'utf8'), { level: 9 });
+
+  // Check the round trip before anything reaches the firmware
+  if (zlib.gunzipSync(gz).toString('utf8') !== html) {
+    throw new Error(variant.name + ': gzip round trip failed');
+  }
+  const etag = '"' + crypto.createHash('sha256').update(gz).digest('hex').slice(0, 16) + '"';
+
+  out += '\n// ' + variant.comment + ' (' + html.length + ' bytes, ' + gz.length + ' gzipped)\n';
+  out += 'constexpr uint8_t ' + variant.name + '_gz[] = {\n' + byteArray(gz) + '\n};\n';
+  out += 'constexpr web_asset_t ' + variant.name + ' = {\n';
+  out += '  ' + variant.name + '_gz, sizeof(' + variant.name + '_gz), "text/html; charset=utf-8", ' + JSON.stringify(etag) + '\n';
+  out += '};\n';
+  console.log(variant.name + ': ' + html.length + ' -> ' + gz.length + ' bytes, ETag ' + etag);
+});
+
+fs.writeFileSync(outFile, out, 'utf8');
+console.log('Wrote ' + path.relative(rootDir, outFile));
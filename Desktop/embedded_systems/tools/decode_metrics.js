@@ -0,0 +1,141 @@
+// Decodes and summarizes a binary telemetry dump from a robot
+//
+// Capture:  curl -o dump.bin "http://192.168.4.1/metrics?format=bin"
+// Usage:    node tools/decode_metrics.js dump.bin [--raw]
+//
+// --raw also prints every trace sample. The layout is written by
+// writeMetricsBinary() in robot_core/telemetry.h.
+const fs = require('fs');
+
+const MAGIC = 0x324d5452; // "RTM2"
+const NAME_LEN = 24;
+
+// trace_type_t values in robot_core/telemetry.h
+const TRACE_TYPES = {
+  1: 'distance_cm',
+  2: 'command_latency_us',
+  3: 'obstacle_reaction_us',
+  4: 'link_lost',
+  5: 'frame_capture_us',
+  6: 'frame_bytes',
+  7: 'frame_send_us',
+  8: 'frames_dropped',
+  9: 'free_heap',
+  10: 'free_psram',
+};
+
+function decode(buf) {
+  let pos = 0;
+  const u32 = () => {
+    const value = buf.readUInt32LE(pos);
+    pos += 4;
+    return value;
+  };
+  const name = () => {
+    const field = buf.subarray(pos, pos + NAME_LEN);
+    pos += NAME_LEN;
+    const end = field.indexOf(0);
+    return field.subarray(0, end < 0 ? NAME_LEN : end).toString('utf8');
+  };
+
+  const magic = u32();
+  if (magic !== MAGIC) {
+    throw new Error('Not a telemetry dump (bad magic)');
+  }
+  const dump = { uptimeMs: u32(), counters: [], hists: [], rings: [] };
+  const counterCount = u32();
+  const histCount = u32();
+  const ringCount = u32();
+  const buckets = u32();
+
+  for (let i = 0; i < counterCount; i++) {
+    dump.counters.push({ name: name(), gauge: u32() !== 0, value: u32() });
+  }
+  for (let i = 0; i < histCount; i++) {
+    const hist = { name: name(), count: u32(), max: u32(), sum: 0, buckets: [] };
+    const low = u32();
+    hist.sum = u32() * 2 ** 32 + low;
+    for (let b = 0; b < buckets; b++) {
+      hist.buckets.push(u32());
+    }
+    dump.hists.push(hist);
+  }
+  for (let i = 0; i < ringCount; i++) {
+    const ring = { name: name(), firstSeq: u32(), samples: [] };
+    const count = u32();
+    for (let s = 0; s < count; s++) {
+      const timeUs = u32();
+      const word = u32();
+      ring.samples.push({ timeUs, type: word >>> 24, value: word & 0xffffff });
+    }
+    dump.rings.push(ring);
+  }
+  return dump;
+}
+
+// Upper bound of the bucket holding the given fraction of the values
+function percentile(hist, fraction) {
+  const target = Math.ceil(hist.count * fraction);
+  let seen = 0;
+  for (let b = 0; b < hist.buckets.length; b++) {
+    seen += hist.buckets[b];
+    if (seen >= target) {
+      return b === hist.buckets.length - 1 ? hist.max : Math.min(2 ** b - 1, hist.max);
+    }
+  }
+  return hist.max;
+}
+
+function summarize(dump, raw) {
+  console.log('Uptime: ' + (dump.uptimeMs / 1000).toFixed(1) + ' s');
+
+  console.log('\nCounters');
+  for (const c of dump.counters) {
+    console.log('  ' + c.name.padEnd(NAME_LEN) + String(c.value).padStart(12) + (c.gauge ? '  (gauge)' : ''));
+  }
+
+  console.log('\nHistograms (percentiles are bucket upper bounds)');
+  console.log('  ' + 'name'.padEnd(22) + ['count', 'mean', 'p50', 'p90', 'p99', 'max'].map((h) => h.padStart(11)).join(''));
+  for (const h of dump.hists) {
+    const cols = h.count ? [h.count, Math.round(h.sum / h.count), percentile(h, 0.5), percentile(h, 0.9), percentile(h, 0.99), h.max] : [0, '-', '-', '-', '-', '-'];
+    console.log('  ' + h.name.padEnd(22) + cols.map((v) => String(v).padStart(11)).join(''));
+  }
+
+  console.log('\nTrace rings');
+  for (const ring of dump.rings) {
+    const samples = ring.samples;
+    if (samples.length === 0) {
+      console.log('  ' + ring.name + ': empty');
+      continue;
+    }
+    const spanMs = ((samples[samples.length - 1].timeUs - samples[0].timeUs) >>> 0) / 1000;
+    console.log('  ' + ring.name + ': ' + samples.length + ' samples over ' + spanMs.toFixed(0) + ' ms (seq ' + ring.firstSeq + '-' + (ring.firstSeq + samples.length - 1) + ')');
+
+    const byType = new Map();
+    for (const s of samples) {
+      if (!byType.has(s.type)) {
+        byType.set(s.type, []);
+      }
+      byType.get(s.type).push(s.value);
+    }
+    for (const [type, values] of byType) {
+      const sum = values.reduce((a, b) => a + b, 0);
+      const label = TRACE_TYPES[type] || 'type_' + type;
+      console.log('    ' + label.padEnd(22) + 'n=' + String(values.length).padEnd(5) +
+        ' min=' + Math.min(...values) + ' avg=' + Math.round(sum / values.length) +
+        ' max=' + Math.max(...values) + ' last=' + values[values.length - 1]);
+    }
+    if (raw) {
+      for (const s of samples) {
+        console.log('      ' + String(s.timeUs).padStart(10) + ' us  ' + (TRACE_TYPES[s.type] || 'type_' + s.type) + ' ' + s.value);
+      }
+    }
+  }
+}
+
+const file = process.argv[2];
+if (!file) {
+  console.error('Usage: node tools/decode_metrics.js dump.bin [--raw]');
+  process.exit(1);
+}
+summarize(decode(fs.readFileSync(file)), process.argv.includes('--raw'));